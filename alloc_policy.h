@@ -0,0 +1,289 @@
+#ifndef ALLOC_POLICY_H
+#define ALLOC_POLICY_H
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parlay/parallel.h"
+
+// Page size and NUMA placement for large per-vertex / per-edge arrays,
+// selected at runtime with
+//   MIS_PAGES = 4k | thp | 2m | 1g        (default 4k)
+//   MIS_NUMA  = firsttouch | interleave   (default firsttouch)
+// thp madvises MADV_HUGEPAGE; 2m/1g map explicit hugetlb pages and fall
+// back to thp when none are reserved. interleave mbinds the range across
+// all online nodes before it is touched; firsttouch leaves placement to
+// the parallel initialization. Arrays owned by the MIS code use
+// PolicyArray; CSR arrays loaded with pread are advised in place via
+// advise_alloc_policy before they are filled.
+enum PagePolicy { PAGES_4K, PAGES_THP, PAGES_2M, PAGES_1G };
+enum NumaPolicy { NUMA_FIRST_TOUCH, NUMA_INTERLEAVE };
+
+struct AllocPolicy {
+  PagePolicy pages = PAGES_4K;
+  NumaPolicy numa = NUMA_FIRST_TOUCH;
+
+  static AllocPolicy from_env() {
+    AllocPolicy p;
+    if (const char *s = std::getenv("MIS_PAGES")) {
+      std::string v(s);
+      if (v == "thp") {
+        p.pages = PAGES_THP;
+      } else if (v == "2m") {
+        p.pages = PAGES_2M;
+      } else if (v == "1g") {
+        p.pages = PAGES_1G;
+      } else if (v != "4k") {
+        std::cerr << "Warning: unknown MIS_PAGES=" << v << ", using 4k"
+                  << std::endl;
+      }
+    }
+    if (const char *s = std::getenv("MIS_NUMA")) {
+      std::string v(s);
+      if (v == "interleave") {
+        p.numa = NUMA_INTERLEAVE;
+      } else if (v != "firsttouch") {
+        std::cerr << "Warning: unknown MIS_NUMA=" << v << ", using firsttouch"
+                  << std::endl;
+      }
+    }
+    return p;
+  }
+};
+
+inline const char *page_policy_name(PagePolicy p) {
+  switch (p) {
+    case PAGES_THP:
+      return "thp";
+    case PAGES_2M:
+      return "2m";
+    case PAGES_1G:
+      return "1g";
+    default:
+      return "4k";
+  }
+}
+
+// Bitmask of online NUMA nodes, from /sys/devices/system/node/online
+// ("0-1,4"). Empty if the file is missing (non-NUMA kernel).
+inline std::vector<unsigned long> online_node_mask(size_t &max_node) {
+  std::vector<unsigned long> mask;
+  max_node = 0;
+  std::ifstream fin("/sys/devices/system/node/online");
+  std::string list;
+  if (!(fin >> list)) return mask;
+  std::stringstream ss(list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    size_t dash = range.find('-');
+    size_t lo = std::strtoul(range.c_str(), nullptr, 10);
+    size_t hi = dash == std::string::npos
+                    ? lo
+                    : std::strtoul(range.c_str() + dash + 1, nullptr, 10);
+    for (size_t node = lo; node <= hi; node++) {
+      size_t word = node / (8 * sizeof(unsigned long));
+      if (mask.size() <= word) mask.resize(word + 1, 0);
+      mask[word] |= 1ul << (node % (8 * sizeof(unsigned long)));
+      max_node = std::max(max_node, node + 1);
+    }
+  }
+  return mask;
+}
+
+// Applies the THP / interleave part of a policy to an existing range of
+// anonymous memory. Pages already touched are migrated by the kernel for
+// interleave (MPOL_MF_MOVE) but keep their size; call it before filling the
+// range to get the full effect. Returns false if the kernel refused.
+inline bool advise_alloc_policy(void *ptr, size_t bytes,
+                                const AllocPolicy &policy) {
+  const uintptr_t kPage = 4096;
+  uintptr_t lo = (reinterpret_cast<uintptr_t>(ptr) + kPage - 1) & ~(kPage - 1);
+  uintptr_t hi = (reinterpret_cast<uintptr_t>(ptr) + bytes) & ~(kPage - 1);
+  if (hi <= lo) return true;
+  bool ok = true;
+  if (policy.pages != PAGES_4K) {
+    ok &= madvise(reinterpret_cast<void *>(lo), hi - lo, MADV_HUGEPAGE) == 0;
+  }
+  if (policy.numa == NUMA_INTERLEAVE) {
+    size_t max_node;
+    auto mask = online_node_mask(max_node);
+    if (!mask.empty()) {
+      const int kMpolInterleave = 3;
+      const unsigned kMpolMfMove = 1 << 1;
+      ok &= syscall(SYS_mbind, lo, hi - lo, kMpolInterleave, mask.data(),
+                    max_node + 1, kMpolMfMove) == 0;
+    }
+  }
+  return ok;
+}
+
+inline void hugetlb_fallback_warning(const std::string &msg) {
+  static bool warned = false;
+  if (!warned) std::cerr << "Warning: " << msg << std::endl;
+  warned = true;
+}
+
+// Fixed-size array of T in its own mapping, placed according to an
+// AllocPolicy. Elements are value-initialized in parallel, which is also
+// the first touch. Move-only.
+template <class T>
+class PolicyArray {
+ public:
+  PolicyArray() {}
+
+  explicit PolicyArray(size_t n, const AllocPolicy &policy = AllocPolicy::from_env())
+      : n_(n) {
+    if (n == 0) return;
+    size_t bytes = n * sizeof(T);
+    obtained_ = PAGES_4K;
+    if (policy.pages == PAGES_2M || policy.pages == PAGES_1G) {
+      size_t shift = policy.pages == PAGES_1G ? 30 : 21;
+      length_ = (bytes + (size_t(1) << shift) - 1) & ~((size_t(1) << shift) - 1);
+      data_ = mmap(0, length_, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB |
+                       static_cast<int>(shift << MAP_HUGE_SHIFT),
+                   -1, 0);
+      if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        hugetlb_fallback_warning("no " + std::string(page_policy_name(policy.pages)) +
+                  " hugetlb pages available (" + std::strerror(errno) +
+                  "), falling back to thp");
+      } else {
+        obtained_ = policy.pages;
+      }
+    }
+    if (!data_) {
+      length_ = (bytes + 4095) & ~size_t(4095);
+      data_ = mmap(0, length_, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (data_ == MAP_FAILED) {
+        std::cerr << "Error: Cannot allocate " << bytes << " bytes"
+                  << std::endl;
+        abort();
+      }
+      if (policy.pages != PAGES_4K) obtained_ = PAGES_THP;
+    }
+    AllocPolicy advice = policy;
+    if (obtained_ != PAGES_THP) advice.pages = PAGES_4K;
+    advise_alloc_policy(data_, length_, advice);
+    T *p = static_cast<T *>(data_);
+    parlay::parallel_for(0, n_, [&](size_t i) { new (p + i) T(); });
+  }
+
+  PolicyArray(const PolicyArray &) = delete;
+  PolicyArray &operator=(const PolicyArray &) = delete;
+  PolicyArray(PolicyArray &&other) noexcept { swap(other); }
+  PolicyArray &operator=(PolicyArray &&other) noexcept {
+    PolicyArray tmp(std::move(other));
+    swap(tmp);
+    return *this;
+  }
+  ~PolicyArray() {
+    if (!data_) return;
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (size_t i = 0; i < n_; i++) begin()[i].~T();
+    }
+    munmap(data_, length_);
+  }
+
+  void swap(PolicyArray &other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(n_, other.n_);
+    std::swap(length_, other.length_);
+    std::swap(obtained_, other.obtained_);
+  }
+
+  T &operator[](size_t i) { return begin()[i]; }
+  const T &operator[](size_t i) const { return begin()[i]; }
+  T *begin() { return static_cast<T *>(data_); }
+  T *end() { return begin() + n_; }
+  const T *begin() const { return static_cast<const T *>(data_); }
+  const T *end() const { return begin() + n_; }
+  size_t size() const { return n_; }
+  // Page policy actually in effect: what was requested, or thp after a
+  // hugetlb fallback.
+  PagePolicy obtained() const { return obtained_; }
+
+ private:
+  void *data_ = nullptr;
+  size_t n_ = 0;
+  size_t length_ = 0;
+  PagePolicy obtained_ = PAGES_4K;
+};
+
+// One line per array: size, then for the mapping (VMA) containing it the
+// kernel page size, RSS, how much is backed by transparent huge pages, the
+// memory policy and the per-node page counts. Adjacent arrays with the
+// same flags may share a VMA and then report the same figures. Read from
+// /proc/self/{smaps,numa_maps}.
+inline void report_page_usage(std::ostream &os, const std::string &name,
+                              const void *ptr, size_t bytes) {
+  uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+  auto in_vma = [&](const std::string &line) {
+    size_t dash = line.find('-');
+    if (dash == std::string::npos || dash > 16) return false;
+    char *end;
+    uintptr_t lo = std::strtoull(line.c_str(), &end, 16);
+    if (*end != '-') return false;
+    uintptr_t hi = std::strtoull(end + 1, &end, 16);
+    if (*end != ' ') return false;
+    return lo <= addr && addr < hi;
+  };
+  std::string page_size = "?", thp = "?", rss = "?";
+  std::ifstream smaps("/proc/self/smaps");
+  std::string line;
+  bool found = false;
+  while (std::getline(smaps, line)) {
+    if (!found) {
+      found = in_vma(line);
+      continue;
+    }
+    std::stringstream ss(line);
+    std::string key, value;
+    ss >> key >> value;
+    if (key == "KernelPageSize:") page_size = value + "kB";
+    if (key == "AnonHugePages:") thp = value + "kB";
+    if (key == "Rss:") rss = value + "kB";
+    if (key == "VmFlags:") break;
+  }
+  // numa_maps has one line per VMA, keyed by its start address
+  std::string nodes, best;
+  uintptr_t best_start = 0;
+  std::ifstream numa_maps("/proc/self/numa_maps");
+  while (std::getline(numa_maps, line)) {
+    uintptr_t start = std::strtoull(line.c_str(), nullptr, 16);
+    if (start <= addr && start >= best_start) {
+      best_start = start;
+      best = line;
+    }
+  }
+  std::stringstream ss(best);
+  std::string tok;
+  ss >> tok;
+  ss >> tok;  // memory policy: default, interleave:0-1, bind:0, ...
+  nodes = " " + tok;
+  while (ss >> tok) {
+    if (tok[0] == 'N' && tok.find('=') != std::string::npos) nodes += " " + tok;
+  }
+  os << std::left << std::setw(14) << name << std::right << std::setw(12)
+     << bytes / 1e6 << " MB  page " << page_size << "  rss " << rss
+     << "  thp " << thp << " " << nodes << "\n";
+}
+
+#endif  // ALLOC_POLICY_H
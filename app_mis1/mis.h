@@ -0,0 +1,162 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+#include "parlay/random.h"
+#include "compact_graph.h"
+#include "counter1.h"
+#include "perf_counters.h"
+#include "simd_count.h"
+
+// 轮次循环；compact > 0 时已决定的顶点占当前图的比例到了 compact 就压缩（见 compact_graph.h），在小图上接着跑
+template <class Graph>
+void AppRounds(const Graph& G, parlay::sequence<std::atomic<uint64_t>>& status, const parlay::sequence<double>& priority,
+               parlay::sequence<SampledCounter<Graph>>& counter, parlay::sequence<typename Graph::NodeId> frontier,
+               double compact, PhaseProfile* prof);
+
+// 压缩：未决定的顶点和它们之间的边打包成新 CSR，在新图上重建 status / priority / counter 接着跑，最后写回。
+// 新计数器按新图精确重数一遍（顺便校准了采样计数），当前 frontier 照搬，计数已经是 0 的也放进 frontier。
+template <class Graph>
+void AppCompact(const Graph& G, parlay::sequence<std::atomic<uint64_t>>& status, const parlay::sequence<double>& priority,
+                const parlay::sequence<typename Graph::NodeId>& frontier, double compact, PhaseProfile* prof) {
+    using NodeId = typename Graph::NodeId;
+    using SubGraph = CompactGraph<NodeId>;
+    enum Status : uint64_t { UNDECIDED = 0, SELECTED = 1, REMOVED = 2 };
+    auto remap = parlay::sequence<NodeId>::uninitialized(G.n);
+    auto sub = compact_subgraph(G, [&](NodeId u) {
+        return status[u].load(std::memory_order_relaxed) == UNDECIDED;
+    }, remap.begin());
+    size_t k = sub.G.n;
+    parlay::sequence<std::atomic<uint64_t>> sub_status(k);
+    parlay::parallel_for(0, k, [&](size_t i) { sub_status[i].store(UNDECIDED, std::memory_order_relaxed); });
+    auto sub_priority = parlay::tabulate(k, [&](size_t i) { return priority[sub.orig[i]]; });
+    parlay::sequence<SampledCounter<SubGraph>> sub_counter = parlay::tabulate(k, [&](size_t i) {
+        int count = count_neighbors_before<true>(sub.G, sub_priority.begin(), static_cast<NodeId>(i));
+        return SampledCounter<SubGraph>(sub.G, static_cast<NodeId>(i), &sub_status, &sub_priority, count);
+    });
+    parlay::sequence<bool> in_frontier(k, false);
+    parlay::parallel_for(0, frontier.size(), [&](size_t i) { in_frontier[remap[frontier[i]]] = true; });
+    auto sub_frontier = parlay::filter(parlay::iota<NodeId>(k), [&](NodeId i) {
+        return in_frontier[i] || sub_counter[i].is_zero();
+    });
+    if (prof) prof->lap("compact");
+
+    AppRounds(sub.G, sub_status, sub_priority, sub_counter, std::move(sub_frontier), compact, prof);
+
+    parlay::parallel_for(0, k, [&](size_t i) {
+        status[sub.orig[i]].store(sub_status[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    });
+    if (prof) prof->lap("compact");
+}
+
+template <class Graph>
+void AppRounds(const Graph& G, parlay::sequence<std::atomic<uint64_t>>& status, const parlay::sequence<double>& priority,
+               parlay::sequence<SampledCounter<Graph>>& counter, parlay::sequence<typename Graph::NodeId> frontier,
+               double compact, PhaseProfile* prof) {
+    using NodeId = typename Graph::NodeId;
+    enum Status : uint64_t { UNDECIDED = 0, SELECTED = 1, REMOVED = 2 };
+    // 只在开了压缩时统计剩下的未决定顶点数；同一个点可能先被删、下一轮又被选，所以只是估计，
+    // 只用来决定什么时候压缩，压缩本身按 status 精确过滤
+    size_t undecided = G.n;
+
+    while (!frontier.empty()) {
+        if (should_compact(G.n, undecided, compact)) {
+            AppCompact(G, status, priority, frontier, compact, prof);
+            return;
+        }
+
+        // 1) 标记 SELECTED
+        parlay::parallel_for(0, frontier.size(), [&](size_t i) {
+            status[frontier[i]].store(SELECTED, std::memory_order_relaxed);
+        });
+
+        // 2) 预留 next_frontier 写空间
+        parlay::sequence<NodeId> next_frontier = parlay::sequence<NodeId>::uninitialized(G.m);
+        std::atomic<size_t> write_ptr = 0;
+        std::atomic<size_t> removed = 0;
+
+        // 3) 邻居设 REMOVED；邻居的邻居(按优先级)扣减
+        parlay::parallel_for(0, frontier.size(), [&](size_t i) {
+            NodeId u = frontier[i];
+            size_t local = 0;
+            for (size_t e = G.offsets[u]; e < G.offsets[u + 1]; e++) {
+                NodeId v = G.edges[e].v;
+
+                uint64_t expected = UNDECIDED;
+                if (status[v].compare_exchange_strong(expected, REMOVED, std::memory_order_acq_rel)) {
+                    local++;
+                    for (size_t f = G.offsets[v]; f < G.offsets[v + 1]; f++) {
+                        NodeId w = G.edges[f].v;
+                        if (status[w].load(std::memory_order_relaxed) == UNDECIDED &&
+                            priority[w] < priority[v]) {
+                            // 外部采样：事件命中时直接调用 -- （内部会减 s）
+                            counter[w]--;
+                            if (counter[w].is_zero()) {
+                                size_t pos = write_ptr.fetch_add(1, std::memory_order_relaxed);
+                                next_frontier[pos] = w;
+                            }
+                        }
+                    }
+                }
+            }
+            if (compact > 0 && local) removed.fetch_add(local, std::memory_order_relaxed);
+        });
+        undecided -= std::min(undecided, frontier.size() + removed.load());
+
+        // 4) 去重 + 裁剪
+        size_t new_size = write_ptr.load(std::memory_order_relaxed);
+        next_frontier = parlay::to_sequence(next_frontier.cut(0, new_size));
+        if (!next_frontier.empty()) {
+            next_frontier = parlay::unique(parlay::sort(std::move(next_frontier)));
+        }
+
+        // 5) 下一轮
+        if (prof) prof->lap_round(frontier.size());
+        frontier = std::move(next_frontier);
+    }
+}
+
+// 度数加权优先级 + 采样计数器的近似 MIS；seed 扰动 hash 优先级
+// compact 见 AppRounds，默认取环境变量 MIS_COMPACT
+template <class Graph>
+parlay::sequence<typename Graph::NodeId> AppMIS(const Graph& G, size_t seed = 0, PhaseProfile* prof = nullptr,
+                                                double compact = compact_fraction_from_env()) {
+    using NodeId = typename Graph::NodeId;
+    size_t n = G.n;
+    if (prof) prof->start();
+
+    enum Status : uint64_t { UNDECIDED = 0, SELECTED = 1, REMOVED = 2 };
+
+    parlay::sequence<std::atomic<uint64_t>> status(n);
+    parlay::sequence<double> priority(n);
+
+    parlay::parallel_for(0, n, [&](size_t u) {
+        status[u].store(UNDECIDED, std::memory_order_relaxed);
+        uint32_t r = parlay::hash32(static_cast<uint32_t>(u) * 2654435761u + static_cast<uint32_t>(seed));
+        double deg = 1.0 + static_cast<double>(G.offsets[u + 1] - G.offsets[u]);
+        priority[u] = static_cast<double>(r) / (static_cast<double>(UINT32_MAX) * deg);
+    });
+
+    // 初始化 Counter：为每个 u 精确数一遍“高优未定邻居数”（这里优先级大的优先，用 gather 比较）
+    parlay::sequence<SampledCounter<Graph>> counter = parlay::tabulate(n, [&](size_t u) {
+        int count = count_neighbors_before<true>(G, priority.begin(), static_cast<NodeId>(u));
+        return SampledCounter<Graph>(G, static_cast<NodeId>(u), &status, &priority, count);
+    });
+
+    // 初始 frontier：计数为 0 的顶点
+    parlay::sequence<NodeId> frontier = parlay::filter(parlay::iota<NodeId>(n), [&](NodeId u) {
+        return counter[u].is_zero();
+    });
+    if (prof) prof->lap("counter_init");
+
+    AppRounds(G, status, priority, counter, std::move(frontier), compact, prof);
+
+    // 输出 SELECTED 集合
+    auto mis = parlay::filter(parlay::iota<NodeId>(n), [&](NodeId u) {
+        return status[u].load(std::memory_order_relaxed) == SELECTED;
+    });
+    if (prof) prof->lap("extract");
+    return mis;
+}
@@ -5,4 +5,5 @@ make
 ./mis ../testcases/bin/hugebubbles-00020_sym.bin
 ./mis ../testcases/bin/eu-2015-host_sym.bin
 ./mis ../testcases/bin/sd_arc_sym.bin
-./mis ../testcases/bin/soc-LiveJournal1_sym.bin
\ No newline at end of file
+./mis ../testcases/bin/soc-LiveJournal1_sym.bin
+#MIS_COMPACT=0.5 ./mis ../testcases/bin/friendster_sym.bin
@@ -0,0 +1,65 @@
+#include "graph.h"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+#include "mis.h"
+#include "par_mis/mis.h"
+using namespace parlay;
+
+// 异步引擎和 par_mis（按轮次）在同一张图、同一个 seed 上各跑 3 次取平均；verify 时检查两者结果完全一样
+template <class F>
+double average_time(F&& f, int runs = 3) {
+    f();  // Warm up
+    double total = 0;
+    for (int run = 0; run < runs; run++) {
+        internal::timer t;
+        f();
+        t.stop();
+        total += t.total_time();
+    }
+    return total / runs;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: ./mis input_graph [verify]" << std::endl;
+        return 1;
+    }
+    const char* filename = argv[1];
+    bool verify = argc == 3 && std::atoi(argv[2]) != 0;
+    Graph<uint32_t, uint64_t> G;
+    G.read_graph(filename);
+    if (!G.symmetrized) { G = make_symmetrized(G); }
+    std::string graphname = std::filesystem::path(filename).stem().string();
+
+    AsyncMISStats stats;
+    parlay::sequence<uint32_t> async_mis;
+    double async_time = average_time([&] { async_mis = AsyncMIS(G, 0, nullptr, &stats); });
+    // AsyncMIS 总是用随机排列，基线和对照也固定成排列，不跟 MIS_PRIORITY 走
+    MISWorkspace<uint32_t> ws;
+    ws.options.priority = PRIORITY_PERMUTATION;
+    size_t rounds = 0;
+    double round_time = average_time([&] {
+        PhaseProfile prof;
+        MIS(G, ws, 0, &prof);
+        rounds = prof.rounds();
+    });
+    std::cout << graphname << "    async " << async_time << "s  (" << stats.workers << " workers, " << stats.steals
+              << " steals, " << stats.failed_steals << " failed)    rounds " << round_time << "s  (" << rounds
+              << " rounds)    x" << round_time / async_time << std::endl;
+    if (verify) {
+        auto reference = MIS(G, ws);
+        if (async_mis == reference) {
+            std::cout << "✅ Verified: identical to par_mis (|MIS| = " << async_mis.size() << ")" << std::endl;
+        } else {
+            std::cout << "❌ Differs from par_mis: " << async_mis.size() << " vs " << reference.size() << std::endl;
+        }
+    }
+    return 0;
+}
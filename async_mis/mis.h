@@ -0,0 +1,115 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+#include "parlay/random.h"
+#include "counter.h"
+#include "deque.h"
+#include "perf_counters.h"
+#include "simd_count.h"
+
+// 无轮次的异步 MIS：和 par_mis 一样的优先级排列和计数器，但没有全局的轮次屏障。
+// 计数器一归零（所有更优先的邻居都已被删），这个点就一定在字典序最小的 MIS 里，立刻处理：
+// 标记 SELECTED，删掉它的邻居 v，再给 v 的更低优先级邻居 w 的计数器减一，归零的 w 推进自己的队列。
+// 每个 worker 一个 Chase–Lev 队列，自己的队列空了就随机挑别人的偷。
+// 结果和 par_mis 的 MIS(G, seed) 完全一样（同一个 seed 的同一个字典序最小 MIS）。
+//
+// 结束判定：pending = 已经就绪但还没处理完的点数。每个就绪的 w 在推进队列之前先给 pending 加一，
+// u 处理完（后继全部推完）之后再减一。推出去的 w 可能马上被别人偷走处理完，但它的那一个早就算进去了，
+// 而 u 自己的那一个要到最后才减，所以 pending 不会提前归零；归零时所有队列都空了、也没人在处理。
+struct AsyncMISStats {
+    size_t steals = 0;        // 成功偷到的次数
+    size_t failed_steals = 0; // 试了但没偷到的次数
+    size_t workers = 0;
+};
+
+template <class Graph>
+parlay::sequence<typename Graph::NodeId> AsyncMIS(const Graph& G, size_t seed = 0, PhaseProfile* prof = nullptr,
+                                                  AsyncMISStats* stats = nullptr) {
+    using NodeId = typename Graph::NodeId;
+    size_t n = G.n;
+    if (prof) prof->start();
+    enum Status : uint64_t { UNDECIDED = 0, SELECTED = 1, REMOVED = 2 };
+
+    auto priority = parlay::random_permutation<NodeId>(n, seed);
+    parlay::sequence<std::atomic<uint64_t>> status(n);
+    parlay::sequence<Counter> counter(n);
+    parlay::parallel_for(0, n, [&](size_t u) {
+        counter[u].reset(count_neighbors_before(G, priority.begin(), static_cast<NodeId>(u)));
+        status[u].store(UNDECIDED, std::memory_order_relaxed);
+    });
+    auto ready = parlay::filter(parlay::iota<NodeId>(n), [&](NodeId u) { return counter[u].is_zero(); });
+    if (prof) prof->lap("counter_init");
+
+    size_t P = std::max<size_t>(1, parlay::num_workers());
+    std::vector<std::unique_ptr<WorkStealingDeque<NodeId>>> deques;
+    for (size_t i = 0; i < P; i++) deques.push_back(std::make_unique<WorkStealingDeque<NodeId>>(1024));
+    std::atomic<int64_t> pending = static_cast<int64_t>(ready.size());
+    std::vector<AsyncMISStats> local_stats(P);
+
+    auto worker = [&](size_t id) {
+        auto& own = *deques[id];
+        // 初始就绪点按块分给各个 worker，自己推进自己的队列
+        size_t lo = ready.size() * id / P, hi = ready.size() * (id + 1) / P;
+        for (size_t i = lo; i < hi; i++) own.push(ready[i]);
+        uint64_t rng = parlay::hash64(id + 1);
+        size_t idle = 0;
+        AsyncMISStats mine;
+        while (pending.load(std::memory_order_acquire) > 0) {
+            NodeId u;
+            bool got = own.pop(u);
+            if (!got && P > 1) {
+                rng ^= rng << 13, rng ^= rng >> 7, rng ^= rng << 17;
+                size_t victim = rng % P;
+                if (victim != id) {
+                    got = deques[victim]->steal(u);
+                    if (got) mine.steals++;
+                    else mine.failed_steals++;
+                }
+            }
+            if (!got) {
+                if (++idle % 64 == 0) std::this_thread::yield();
+                continue;
+            }
+            idle = 0;
+            status[u].store(SELECTED, std::memory_order_relaxed);
+            G.map_neighbors(u, [&](NodeId v) {
+                uint64_t expected = UNDECIDED;
+                if (status[v].compare_exchange_strong(expected, REMOVED)) {
+                    G.map_neighbors(v, [&](NodeId w) {
+                        if (status[w].load() == UNDECIDED && priority[w] > priority[v]) {
+                            if (counter[w].decrement_to_zero()) {
+                                pending.fetch_add(1, std::memory_order_acq_rel);
+                                own.push(w);
+                            }
+                        }
+                    });
+                }
+            });
+            pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+        local_stats[id] = mine;
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < P; i++) threads.emplace_back(worker, i);
+    worker(0);
+    for (auto& t : threads) t.join();
+    if (prof) prof->lap("async");
+
+    if (stats) {
+        *stats = AsyncMISStats();
+        stats->workers = P;
+        for (auto& s : local_stats) {
+            stats->steals += s.steals;
+            stats->failed_steals += s.failed_steals;
+        }
+    }
+    auto mis = parlay::filter(parlay::iota<NodeId>(n), [&](NodeId u) { return status[u] == SELECTED; });
+    if (prof) prof->lap("extract");
+    return mis;
+}
@@ -0,0 +1,6 @@
+make clean
+make
+./mis ../testcases/bin/RoadUSA_sym.bin 1
+./mis ../testcases/bin/europe_sym.bin 1
+./mis ../testcases/bin/planet_sym.bin 1
+#./mis ../testcases/bin/friendster.bin 1
\ No newline at end of file
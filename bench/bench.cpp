@@ -0,0 +1,218 @@
+#include "graph.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+#include "par_mis/mis.h"
+#include "seq_mis/mis.h"
+#include "seq_mis/mis_dag.h"
+#include "app_mis1/mis.h"
+#include "bit_mis/mis.h"
+#include "async_mis/mis.h"
+#include "perf_counters.h"
+using namespace parlay;
+
+// 所有 MIS 引擎在同一份已加载的图上跑，结果汇总到一个 CSV
+using BenchGraph = Graph<uint32_t, uint64_t>;
+
+struct RunResult {
+    size_t mis_size;
+    size_t rounds;
+};
+
+template <class G>
+struct Engine {
+    std::string name;
+    std::function<RunResult(const G&, size_t, PhaseProfile*)> run;
+};
+
+template <class G>
+std::vector<Engine<G>> all_engines() {
+    return {
+        {"par_mis", [](const G& g, size_t seed, PhaseProfile* prof) {
+             // 工作区跨 warm up / 重复运行复用，只计算法本身
+             static MISWorkspace<typename G::NodeId> ws;
+             auto mis = MIS(g, ws, seed, prof);
+             return RunResult{mis.size(), prof->rounds()};
+         }},
+        {"seq_mis", [](const G& g, size_t seed, PhaseProfile* prof) {
+             auto mis = SeqMIS(g, true, seed, prof);
+             return RunResult{mis.size(), prof->rounds()};
+         }},
+        {"mis_dag", [](const G& g, size_t seed, PhaseProfile* prof) {
+             auto mis = MIS_DAG(g, seed, prof);
+             return RunResult{mis.size(), prof->rounds()};
+         }},
+        {"app_mis1", [](const G& g, size_t seed, PhaseProfile* prof) {
+             auto mis = AppMIS(g, seed, prof);
+             return RunResult{mis.size(), prof->rounds()};
+         }},
+        {"bit_mis", [](const G& g, size_t seed, PhaseProfile* prof) {
+             // 一次遍历跑 64 个顺序；计时是 64 个实例的总时间，大小报第 0 条 lane
+             auto res = BitMIS(g, seed, prof);
+             return RunResult{res.sizes[0], prof->rounds()};
+         }},
+        {"async_mis", [](const G& g, size_t seed, PhaseProfile* prof) {
+             auto mis = AsyncMIS(g, seed, prof);
+             return RunResult{mis.size(), prof->rounds()};
+         }},
+    };
+}
+
+struct BenchConfig {
+    std::vector<std::string> engine_names;
+    std::vector<size_t> seeds;
+    int repetitions;
+    int warmups;
+};
+
+template <class G>
+void bench_graph(const G& graph, const std::string& graphname, const BenchConfig& cfg, std::ofstream& csv) {
+    std::cout << graphname << "  n=" << graph.n << " m=" << graph.m << std::endl;
+    for (auto& engine : all_engines<G>()) {
+        if (!cfg.engine_names.empty() &&
+            std::find(cfg.engine_names.begin(), cfg.engine_names.end(), engine.name) == cfg.engine_names.end()) {
+            continue;
+        }
+        for (size_t seed : cfg.seeds) {
+            PhaseProfile prof;
+            for (int w = 0; w < cfg.warmups; w++) engine.run(graph, seed, &prof);
+            std::vector<double> times;
+            RunResult res{0, 0};
+            for (int run = 0; run < cfg.repetitions; run++) {
+                internal::timer t;
+                res = engine.run(graph, seed, &prof);
+                t.stop();
+                times.push_back(t.total_time());
+            }
+            std::vector<double> sorted = times;
+            std::sort(sorted.begin(), sorted.end());
+            size_t k = sorted.size();
+            double median = (k % 2) ? sorted[k / 2] : (sorted[k / 2 - 1] + sorted[k / 2]) / 2;
+            double mean = std::accumulate(times.begin(), times.end(), 0.0) / k;
+            double var = 0;
+            for (double t : times) var += (t - mean) * (t - mean);
+            double stddev = std::sqrt(var / k);
+            double gteps = graph.m / median / 1e9;
+
+            csv << graphname << "," << graph.n << "," << graph.m << "," << engine.name << ","
+                << seed << "," << cfg.repetitions << "," << median << "," << sorted[0] << ","
+                << stddev << "," << res.mis_size << "," << res.rounds << "," << gteps << "\n";
+            csv.flush();
+            std::cout << "    " << engine.name << " seed=" << seed << "  median " << median
+                      << "s  min " << sorted[0] << "s  stddev " << stddev
+                      << "  |MIS|=" << res.mis_size << "  rounds=" << res.rounds
+                      << "  " << gteps << " GTEPS" << std::endl;
+        }
+    }
+}
+
+std::vector<std::string> split(const std::string& s, char sep) {
+    std::vector<std::string> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, sep)) {
+        if (!item.empty()) out.push_back(item);
+    }
+    return out;
+}
+
+std::vector<std::string> read_graphnames(const std::string& filename) {
+    std::vector<std::string> graphs;
+    std::ifstream fin(filename);
+    if (!fin.is_open()) {
+        std::cerr << "Error: Cannot open graph list " << filename << std::endl;
+        exit(1);
+    }
+    std::string line;
+    while (std::getline(fin, line)) {
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (!line.empty() && line[0] != '#') graphs.push_back(line);
+    }
+    return graphs;
+}
+
+void usage() {
+    std::cerr << "Usage: ./bench [-i graphnames.txt] [-d graph_dir] [-g graph1,graph2]\n"
+              << "               [-e engine1,engine2] [-s seed1,seed2] [-r repetitions]\n"
+              << "               [-w warmups] [-o output.csv]\n"
+              << "engines: par_mis, seq_mis, mis_dag, app_mis1, bit_mis, async_mis (default: all)\n"
+              << "graphs: names under graph_dir, or shm:<name> for a graph resident in shared memory" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::string list_file = "../testcases/graphnames.txt";
+    std::string graph_dir = "../testcases/bin/";
+    std::string output_file = "./results/bench.csv";
+    std::vector<std::string> graphs;
+    std::vector<std::string> engine_names;
+    std::vector<size_t> seeds = {0};
+    int repetitions = 3;
+    int warmups = 1;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) { usage(); return 1; }
+        std::string val = argv[++i];
+        if (arg == "-i") list_file = val;
+        else if (arg == "-d") graph_dir = val;
+        else if (arg == "-g") graphs = split(val, ',');
+        else if (arg == "-e") engine_names = split(val, ',');
+        else if (arg == "-r") repetitions = std::atoi(val.c_str());
+        else if (arg == "-w") warmups = std::atoi(val.c_str());
+        else if (arg == "-o") output_file = val;
+        else if (arg == "-s") {
+            seeds.clear();
+            for (auto& s : split(val, ',')) seeds.push_back(std::strtoull(s.c_str(), nullptr, 10));
+        } else { usage(); return 1; }
+    }
+    if (repetitions < 1 || seeds.empty()) { usage(); return 1; }
+    if (graphs.empty()) graphs = read_graphnames(list_file);
+    if (!graph_dir.empty() && graph_dir.back() != '/') graph_dir += '/';
+
+    BenchConfig cfg{engine_names, seeds, repetitions, warmups};
+    for (auto& name : engine_names) {
+        bool known = false;
+        for (auto& e : all_engines<BenchGraph>()) known |= (e.name == name);
+        if (!known) { usage(); return 1; }
+    }
+
+    std::filesystem::path p(output_file);
+    if (!p.parent_path().empty()) std::filesystem::create_directories(p.parent_path());
+    std::ofstream csv(output_file);
+    if (!csv.is_open()) {
+        std::cerr << "Error: Cannot open output file " << output_file << std::endl;
+        return 1;
+    }
+    csv << "graph,n,m,engine,seed,repetitions,median_s,min_s,stddev_s,mis_size,rounds,gteps\n";
+
+    for (auto& graphname : graphs) {
+        // shm:<name>：挂载 tools/shm_graph 常驻的图，不读文件
+        if (graphname.rfind("shm:", 0) == 0) {
+            GraphView<uint32_t, uint64_t> G;
+            G.attach(graphname.substr(4));
+            bench_graph(G, std::filesystem::path(graphname.substr(4)).stem().string(), cfg, csv);
+            continue;
+        }
+        std::string filename = graph_dir + graphname + ".bin";
+        if (!std::filesystem::exists(filename)) {
+            std::cerr << "Warning: skipping missing graph " << filename << std::endl;
+            continue;
+        }
+        // 每张图只加载一次，所有引擎共用
+        BenchGraph G;
+        G.read_graph(filename.c_str());
+        if (!G.symmetrized) { G = make_symmetrized(G); }
+        bench_graph(G, graphname, cfg, csv);
+    }
+    return 0;
+}
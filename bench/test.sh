@@ -0,0 +1,4 @@
+make clean
+make
+./bench -r 3 -s 0,1,2 -o ./results/bench.csv
+#./bench -e par_mis,seq_mis -g friendster_sym,com-orkut_sym -r 5
@@ -0,0 +1,127 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+#include "parlay/utilities.h"
+#include "perf_counters.h"
+#include "priority.h"
+
+// 64 个字典序最小 MIS 同时跑：每个顶点一个 64 位字，第 l 位就是第 l 条 lane（第 l 个随机顺序）的状态，
+// 每次读邻接表都同时服务 64 条 lane。
+//
+// lane l 的优先级是 HashRank(n, bit_mis_lane_seed(seed, l))，每条 lane 一个独立的 key，
+// 所以 lane l 的结果就是 MIS_PRIORITY=hash 时 par_mis 用 seed * 64 + l 算出来的 MIS，可以逐条对照。
+// 64 条 lane 的排名按位切片存：slices[u * bits + b] 的第 l 位是 lane l 里 u 的排名的第 b 位
+// （每个顶点 bits 个字，bits 是排名的位数，n = 2^20 时 20 个字）。比较 w、u 时从最高位往下，
+// 64 条 lane 一起做逐位比较，所有 lane 都分出大小就停，通常看几位就够。
+//
+// 按 rootset 的方式分轮：没有更优先的未决定邻居的顶点入选，再删掉入选点的邻居，直到所有 lane 都决定完。
+struct BitMISResult {
+    parlay::sequence<uint64_t> in_mis;      // in_mis[u] 的第 l 位：u 在 lane l 的 MIS 里
+    std::array<size_t, 64> sizes;           // 每条 lane 的 MIS 大小
+    size_t seed;
+    size_t rounds;
+};
+
+// lane l 用的 hash 优先级种子
+inline size_t bit_mis_lane_seed(size_t seed, size_t lane) { return seed * 64 + lane; }
+
+// 64x64 位矩阵转置：a[b] 的第 l 位 <- 原 a[l] 的第 b 位
+inline void transpose64(uint64_t* a) {
+    uint64_t m = 0x00000000FFFFFFFFull;
+    for (int j = 32; j != 0; j >>= 1, m ^= (m << j)) {
+        for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+            uint64_t t = ((a[k] >> j) ^ a[k | j]) & m;
+            a[k] ^= t << j;
+            a[k | j] ^= t;
+        }
+    }
+}
+
+template <class Graph>
+BitMISResult BitMIS(const Graph& G, size_t seed = 0, PhaseProfile* prof = nullptr) {
+    using NodeId = typename Graph::NodeId;
+    constexpr uint64_t ALL = ~uint64_t(0);
+    size_t n = G.n;
+    if (prof) prof->start();
+
+    BitMISResult res;
+    res.seed = seed;
+    std::vector<HashRank> ranks;
+    for (size_t l = 0; l < 64; l++) ranks.emplace_back(n, bit_mis_lane_seed(seed, l));
+    const size_t bits = __builtin_ctzll(ranks[0].range());
+    auto slices = parlay::sequence<uint64_t>::uninitialized(n * bits);
+    parlay::parallel_for(0, n, [&](size_t u) {
+        uint64_t a[64];
+        for (size_t l = 0; l < 64; l++) a[l] = ranks[l](u);
+        transpose64(a);
+        for (size_t b = 0; b < bits; b++) slices[u * bits + b] = a[b];
+    });
+    // lanes 里 w 比 u 优先的 lane 集合（排名各不相同，每条 lane 总能分出先后）
+    auto before = [&](NodeId w, NodeId u, uint64_t lanes) -> uint64_t {
+        const uint64_t* sw = slices.begin() + w * bits;
+        const uint64_t* su = slices.begin() + u * bits;
+        uint64_t lt = 0, eq = lanes;
+        for (size_t b = bits; b-- > 0 && eq;) {
+            lt |= eq & ~sw[b] & su[b];
+            eq &= ~(sw[b] ^ su[b]);
+        }
+        return lt;
+    };
+
+    auto& in = res.in_mis;
+    in = parlay::sequence<uint64_t>(n, 0);
+    parlay::sequence<uint64_t> out(n, 0);        // out[u] 的第 l 位：u 在 lane l 被删掉
+    parlay::sequence<uint64_t> roots(n, 0);      // 本轮在各 lane 入选的位
+    auto active = parlay::tabulate(n, [](size_t u) { return static_cast<NodeId>(u); });
+    if (prof) prof->lap("init");
+
+    res.rounds = 0;
+    while (!active.empty()) {
+        // step 1: 在还没决定的 lane 里，没有更优先的未决定邻居就是 root（只读 in/out，写 roots）
+        parlay::parallel_for(0, active.size(), [&](size_t i) {
+            NodeId u = active[i];
+            uint64_t r = ~(in[u] | out[u]);
+            G.map_neighbors(u, [&](NodeId w) {
+                uint64_t lanes = r & ~(in[w] | out[w]);
+                if (lanes) r &= ~before(w, u, lanes);
+            });
+            roots[u] = r;
+        });
+        // step 2: root 入选；邻居在某条 lane 是 root，就在那条 lane 被删掉
+        parlay::parallel_for(0, active.size(), [&](size_t i) {
+            NodeId u = active[i];
+            uint64_t undecided = ~(in[u] | out[u]);
+            uint64_t removed = 0;
+            G.map_neighbors(u, [&](NodeId w) { removed |= roots[w]; });
+            in[u] |= roots[u];
+            out[u] |= removed & undecided & ~roots[u];
+        });
+        // step 3: 清掉本轮的 roots，所有 lane 都决定了的顶点退出
+        parlay::parallel_for(0, active.size(), [&](size_t i) { roots[active[i]] = 0; });
+        if (prof) prof->lap_round(active.size());
+        active = parlay::filter(active, [&](NodeId u) { return (in[u] | out[u]) != ALL; });
+        res.rounds++;
+    }
+
+    // 每条 lane 的 MIS 大小：按块统计再原子累加
+    std::array<std::atomic<size_t>, 64> counts;
+    for (auto& c : counts) c.store(0, std::memory_order_relaxed);
+    const size_t BLOCK = 4096;
+    parlay::parallel_for(0, (n + BLOCK - 1) / BLOCK, [&](size_t b) {
+        std::array<size_t, 64> local{};
+        for (size_t u = b * BLOCK; u < std::min(n, (b + 1) * BLOCK); u++) {
+            for (uint64_t x = in[u]; x; x &= x - 1) local[__builtin_ctzll(x)]++;
+        }
+        for (size_t l = 0; l < 64; l++) {
+            if (local[l]) counts[l].fetch_add(local[l], std::memory_order_relaxed);
+        }
+    });
+    for (size_t l = 0; l < 64; l++) res.sizes[l] = counts[l].load();
+    if (prof) prof->lap("extract");
+    return res;
+}
@@ -0,0 +1,5 @@
+make clean
+make
+./mis ../testcases/bin/friendster.bin
+#./mis ../testcases/bin/com-orkut.bin 1
+#./mis ../testcases/bin/hugebubbles-00020_sym.bin 1
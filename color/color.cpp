@@ -0,0 +1,111 @@
+#include "graph.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+#include "color.h"
+using namespace parlay;
+
+using ColorGraph = Graph<uint32_t, uint64_t>;
+
+struct ColorTiming {
+    double avg;
+    size_t colors;
+    size_t rounds;
+};
+
+// warm up 一次，再跑 3 次取平均
+ColorTiming time_color(const ColorGraph& G, ColorWorkspace<uint32_t>& ws, parlay::sequence<uint32_t>& colors) {
+    colors = JonesPlassmann(G, ws);
+    double total = 0;
+    for (int run = 0; run < 3; run++) {
+        internal::timer t;
+        colors = JonesPlassmann(G, ws);
+        t.stop();
+        total += t.total_time();
+    }
+    size_t used = G.n ? parlay::reduce(colors, parlay::maxm<uint32_t>()) + 1 : 0;
+    return {total / 3, used, ws.rounds};
+}
+
+// 检查：两端同色的边数（自环不算）
+size_t count_conflicts(const ColorGraph& G, const parlay::sequence<uint32_t>& colors) {
+    return parlay::reduce(parlay::delayed_seq<size_t>(G.n, [&](size_t u) {
+        size_t bad = 0;
+        G.map_neighbors(u, [&](uint32_t v) { bad += v != u && colors[v] == colors[u]; });
+        return bad;
+    })) / 2;
+}
+
+// 对照：按同样的优先级串行贪心，JP 的结果应该和它完全一样
+template <class Rank>
+parlay::sequence<uint32_t> greedy_coloring(const ColorGraph& G, const Rank& rank) {
+    auto order = parlay::sort(parlay::iota<uint32_t>(G.n), [&](uint32_t a, uint32_t b) { return rank(a) < rank(b); });
+    parlay::sequence<uint32_t> colors(G.n, 0);
+    for (uint32_t u : order) colors[u] = smallest_free_color(G, colors.begin(), rank, u);
+    return colors;
+}
+
+bool same_as_greedy(const ColorGraph& G, ColorWorkspace<uint32_t>& ws, const parlay::sequence<uint32_t>& colors) {
+    if (ws.priority_kind == PRIORITY_HASH) return greedy_coloring(G, HashRank(G.n, 0)) == colors;
+    return greedy_coloring(G, StoredRank<uint32_t>{ws.priority.begin()}) == colors;
+}
+
+// --priority：每种优先级各跑一遍，比颜色数、轮数和时间
+int priority_bench(const ColorGraph& G) {
+    size_t max_degree = parlay::reduce(parlay::delayed_seq<size_t>(G.n, [&](size_t u) { return G.degree(u); }),
+                                       parlay::maxm<size_t>());
+    std::cout << "priority  n=" << G.n << " m=" << G.m << " max degree " << max_degree << std::endl;
+    for (PriorityKind kind : kPriorityKinds) {
+        ColorWorkspace<uint32_t> ws;
+        ws.priority_kind = kind;
+        parlay::sequence<uint32_t> colors;
+        ColorTiming timing = time_color(G, ws, colors);
+        std::cout << "    " << std::left << std::setw(10) << priority_kind_name(kind) << std::right << "  "
+                  << timing.avg << "s  colors " << timing.colors << "  rounds " << timing.rounds
+                  << (count_conflicts(G, colors) ? "  (CONFLICTS)" : "") << std::endl;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: ./color input_graph [verify]\n"
+                  << "       ./color input_graph --priority  (colors / rounds / time per MIS_PRIORITY kind)"
+                  << std::endl;
+        return 1;
+    }
+    const char* filename = argv[1];
+    std::string mode = argc == 3 ? argv[2] : "";
+    std::string graphname = std::filesystem::path(filename).stem().string();
+    ColorGraph G;
+    G.read_graph(filename);
+    if (!G.symmetrized) {
+        G = make_symmetrized(G);
+    }
+    if (mode == "--priority") return priority_bench(G);
+
+    ColorWorkspace<uint32_t> ws;
+    parlay::sequence<uint32_t> colors;
+    ColorTiming timing = time_color(G, ws, colors);
+    std::cout << graphname << "    " << timing.avg << "s  colors " << timing.colors << "  rounds " << timing.rounds
+              << "  (" << priority_kind_name(ws.priority_kind) << ")" << std::endl;
+    size_t conflicts = count_conflicts(G, colors);
+    if (conflicts != 0) std::cout << "❌ coloring invalid: " << conflicts << " conflicting edges" << std::endl;
+    bool verify = argc == 3 && std::atoi(argv[2]) != 0;
+    if (verify) {
+        if (!same_as_greedy(G, ws, colors)) std::cout << "⚠️ differs from sequential greedy in priority order\n";
+        std::filesystem::create_directories("./results");
+        std::ofstream out("./results/" + graphname + "_color.txt");
+        out << "# colors: " << timing.colors << "\n";
+        for (size_t u = 0; u < G.n; u++) out << colors[u] << "\n";
+    }
+    return conflicts == 0 ? 0 : 1;
+}
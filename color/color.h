@@ -0,0 +1,144 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+#include "alloc_policy.h"
+#include "counter.h"
+#include "perf_counters.h"
+#include "priority.h"
+
+// Jones–Plassmann 着色：和 par_mis 同一套“更优先的邻居都处理完了才轮到我”的调度。
+// counter[u] = 比 u 优先的邻居个数，为 0 的进 frontier；frontier 里的顶点两两不相邻，
+// 每个取比它优先的邻居没用过的最小颜色，再给比它后的邻居计数器减一，从 1 变 0 的进下一轮 frontier。
+// 结果和按优先级顺序串行贪心着色完全一样，颜色数不超过最大度数 + 1。
+//
+// 优先级按 MIS_PRIORITY（见 priority.h）：
+//   perm / hash   随机顺序（经典 JP）
+//   degree        反过来用，度数大的先着色（Largest-First）
+//   degeneracy    反过来用，后剥离的先着色（Smallest-Last，近似退化序，即 JP-ADG）
+// 找最小可用颜色：度数小于 64 时，比它优先的邻居的颜色记在一个 64 位的位图里，取最低的 0 位；
+// 度数更大时用一个 deg + 1 大小的标记数组（颜色 > deg 的不可能是答案，不用记）。
+constexpr size_t kColorBitsetDegree = 64;
+
+template <class NodeId>
+struct ColorWorkspace {
+    size_t n = 0;
+    AllocPolicy policy = AllocPolicy::from_env();
+    PriorityKind priority_kind = priority_kind_from_env();
+    PolicyArray<NodeId> priority;      // 存排名时：0..n-1，越小越先着色
+    PolicyArray<Counter> counter;
+    PolicyArray<uint32_t> color;
+    PolicyArray<NodeId> frontier;
+    PolicyArray<NodeId> next_frontier;
+    size_t rounds = 0;                 // 上一次调用的轮数
+    size_t priority_seed = 0;
+    PriorityKind prepared_kind = PRIORITY_PERMUTATION;
+    GraphKey priority_graph;
+    bool has_priority = false;
+
+    void resize(size_t _n) {
+        if (_n == n) return;
+        n = _n;
+        counter = PolicyArray<Counter>(n, policy);
+        color = PolicyArray<uint32_t>(n, policy);
+        frontier = PolicyArray<NodeId>(n, policy);
+        next_frontier = PolicyArray<NodeId>(n, policy);
+        priority = PolicyArray<NodeId>();
+        has_priority = false;
+    }
+
+    // 存排名的路径，同一个 seed、同一种优先级（degree / degeneracy 还要同一张图，按 GraphKey 认，和 MISWorkspace 一样）只生成一次。
+    // degree / degeneracy 的排名是给 MIS 用的（小度数先），着色时倒过来
+    template <class Graph>
+    void prepare(const Graph& G, size_t seed) {
+        GraphKey graph = priority_kind == PRIORITY_PERMUTATION ? GraphKey{} : GraphKey::of(G);
+        if (has_priority && priority_seed == seed && prepared_kind == priority_kind && priority_graph == graph) return;
+        if (priority.size() != n) priority = PolicyArray<NodeId>(n, policy);
+        priority_seed = seed;
+        prepared_kind = priority_kind;
+        priority_graph = graph;
+        has_priority = true;
+        stored_ranks(G, priority_kind, seed, priority.begin());
+        if (priority_kind == PRIORITY_DEGREE || priority_kind == PRIORITY_DEGENERACY) {
+            parlay::parallel_for(0, n, [&](size_t u) { priority[u] = static_cast<NodeId>(n - 1 - priority[u]); });
+        }
+    }
+};
+
+// 比 u 优先的邻居都着好色之后，它们没用过的最小颜色
+template <class Graph, class Rank>
+uint32_t smallest_free_color(const Graph& G, const uint32_t* color, const Rank& rank, typename Graph::NodeId u) {
+    using NodeId = typename Graph::NodeId;
+    size_t deg = G.degree(u);
+    auto ru = rank(u);
+    if (deg < kColorBitsetDegree) {
+        uint64_t used = 0;
+        G.map_neighbors(u, [&](NodeId v) {
+            if (rank(v) < ru && color[v] < kColorBitsetDegree) used |= uint64_t(1) << color[v];
+        });
+        return static_cast<uint32_t>(__builtin_ctzll(~used));
+    }
+    std::vector<uint8_t> used(deg + 1, 0);
+    G.map_neighbors(u, [&](NodeId v) {
+        if (rank(v) < ru && color[v] <= deg) used[color[v]] = 1;
+    });
+    return static_cast<uint32_t>(std::find(used.begin(), used.end(), 0) - used.begin());
+}
+
+template <class Graph, class Rank>
+void color_rounds(const Graph& G, ColorWorkspace<typename Graph::NodeId>& ws, const Rank& rank,
+                  PhaseProfile* prof) {
+    using NodeId = typename Graph::NodeId;
+    size_t n = G.n;
+    auto& counter = ws.counter;
+    auto& color = ws.color;
+    parlay::parallel_for(0, n, [&](size_t u) {
+        counter[u].reset(count_neighbors_before(G, rank, static_cast<NodeId>(u)));
+    });
+    size_t frontier_size = parlay::filter_into_uninitialized(
+        parlay::iota<NodeId>(n), ws.frontier, [&](NodeId u) { return counter[u].is_zero(); });
+    if (prof) prof->lap("counter_init");
+
+    ws.rounds = 0;
+    while (frontier_size != 0) {
+        auto& frontier = ws.frontier;
+        auto& next_frontier = ws.next_frontier;
+        std::atomic<size_t> write_ptr = 0;
+        parlay::parallel_for(0, frontier_size, [&](size_t i) {
+            NodeId u = frontier[i];
+            color[u] = smallest_free_color(G, color.begin(), rank, u);
+            auto ru = rank(u);
+            G.map_neighbors(u, [&](NodeId w) {
+                if (rank(w) > ru && counter[w].decrement_to_zero()) {
+                    next_frontier[write_ptr.fetch_add(1)] = w;
+                }
+            });
+        });
+        ws.rounds++;
+        if (prof) prof->lap_round(frontier_size);
+        std::swap(ws.frontier, ws.next_frontier);
+        frontier_size = write_ptr.load();
+    }
+}
+
+// 返回每个顶点的颜色（从 0 开始）。seed 决定优先级；同一 seed 下结果确定
+template <class Graph>
+parlay::sequence<uint32_t> JonesPlassmann(const Graph& G, ColorWorkspace<typename Graph::NodeId>& ws,
+                                          size_t seed = 0, PhaseProfile* prof = nullptr) {
+    using NodeId = typename Graph::NodeId;
+    if (prof) prof->start();
+    ws.resize(G.n);
+    if (ws.priority_kind == PRIORITY_HASH) {
+        color_rounds(G, ws, HashRank(G.n, seed), prof);
+    } else {
+        ws.prepare(G, seed);
+        color_rounds(G, ws, StoredRank<NodeId>{ws.priority.begin()}, prof);
+    }
+    auto colors = parlay::tabulate(G.n, [&](size_t u) { return ws.color[u]; });
+    if (prof) prof->lap("extract");
+    return colors;
+}
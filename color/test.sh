@@ -0,0 +1,6 @@
+make clean
+make
+for g in $(grep -v '^#' ../testcases/graphnames.txt); do ./color ../testcases/bin/$g.bin; done
+#./color ../testcases/bin/friendster_sym.bin 1
+#MIS_PRIORITY=degeneracy ./color ../testcases/bin/friendster_sym.bin
+#./color ../testcases/bin/com-orkut_sym.bin --priority
@@ -0,0 +1,82 @@
+#ifndef COMPACT_GRAPH_H
+#define COMPACT_GRAPH_H
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "graph.h"
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+
+// Compaction of the still-undecided part of a graph between MIS rounds.
+// Once most vertices are SELECTED or REMOVED, every round still walks their
+// entries in the adjacency lists of the remaining vertices. Packing the
+// remaining vertices and the edges among them into a fresh CSR (with new,
+// dense ids) makes the late rounds scan only live edges. Controlled by
+//   MIS_COMPACT = fraction of decided vertices that triggers a compaction
+// e.g. 0.5 compacts whenever half of the current graph is decided (so
+// repeatedly, each time relative to the last compacted graph). 0 (the
+// default) disables it.
+constexpr size_t kMinCompactVertices = 4096;  // smaller graphs never compact
+
+inline double compact_fraction_from_env() {
+  const char *s = std::getenv("MIS_COMPACT");
+  if (!s) return 0;
+  double f = std::strtod(s, nullptr);
+  return f > 0 && f < 1 ? f : 0;
+}
+
+// True if a graph of n vertices with `undecided` of them left should be
+// compacted under fraction f.
+inline bool should_compact(size_t n, size_t undecided, double f) {
+  return f > 0 && n >= kMinCompactVertices &&
+         static_cast<double>(undecided) <= (1 - f) * static_cast<double>(n);
+}
+
+template <class NodeId>
+using CompactGraph = Graph<NodeId, uint64_t>;
+
+template <class NodeId>
+struct Subgraph {
+  CompactGraph<NodeId> G;
+  parlay::sequence<NodeId> orig;  // new id -> id in the input graph
+};
+
+// The subgraph induced by the vertices with keep(u). New ids follow the old
+// id order and neighbor lists keep their order. remap (n entries, scratch
+// owned by the caller) receives old id -> new id for the kept vertices; the
+// entries of the other vertices are left untouched.
+template <class Graph, class Keep>
+Subgraph<typename Graph::NodeId> compact_subgraph(
+    const Graph &G, Keep &&keep, typename Graph::NodeId *remap) {
+  using NodeId = typename Graph::NodeId;
+  using Edge = typename CompactGraph<NodeId>::Edge;
+  Subgraph<NodeId> sub;
+  sub.orig = parlay::filter(parlay::iota<NodeId>(G.n),
+                            [&](NodeId u) { return keep(u); });
+  size_t k = sub.orig.size();
+  parlay::parallel_for(0, k, [&](size_t i) {
+    remap[sub.orig[i]] = static_cast<NodeId>(i);
+  });
+  auto &H = sub.G;
+  H.n = k;
+  H.symmetrized = true;
+  H.weighted = false;
+  H.offsets = parlay::sequence<uint64_t>(k + 1, 0);
+  parlay::parallel_for(0, k, [&](size_t i) {
+    uint64_t deg = 0;
+    G.map_neighbors(sub.orig[i], [&](NodeId v) { deg += keep(v); });
+    H.offsets[i] = deg;
+  });
+  H.m = parlay::scan_inplace(H.offsets);
+  H.edges = parlay::sequence<Edge>::uninitialized(H.m);
+  parlay::parallel_for(0, k, [&](size_t i) {
+    uint64_t pos = H.offsets[i];
+    G.map_neighbors(sub.orig[i], [&](NodeId v) {
+      if (keep(v)) H.edges[pos++] = Edge(remap[v]);
+    });
+  });
+  return sub;
+}
+
+#endif  // COMPACT_GRAPH_H
@@ -129,7 +129,18 @@ struct Counter {
     inline int get_approxmt() { return approxmt_count.load(std::memory_order_relaxed); }
     inline void decrement() noexcept { approxmt_count.fetch_sub(1, std::memory_order_relaxed); }
     inline void operator--(int) noexcept { decrement(); }
+    // 动态维护（dyn_mis）时计数也会加回去
+    inline void increment() noexcept { approxmt_count.fetch_add(1, std::memory_order_relaxed); }
     inline bool is_zero() noexcept { return !approxmt_count.load(std::memory_order_relaxed); }
+    // 复用计数器（MISWorkspace）时重新赋初值
+    inline void reset(int verified) noexcept {
+        verified_value = verified;
+        approxmt_count.store(verified, std::memory_order_relaxed);
+    }
+    // 扣减，并且只有把计数从 1 扣到 0 的那一次返回 true（恰好一次）
+    inline bool decrement_to_zero() noexcept {
+        return approxmt_count.fetch_sub(1, std::memory_order_relaxed) == 1;
+    }
 };
 
 
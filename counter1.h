@@ -4,12 +4,12 @@
 #include <cstdint>
 #include <thread>
 
-#ifndef WIDTH
-#define WIDTH 100
+#ifndef SAMPLE_WIDTH
+#define SAMPLE_WIDTH 100
 #endif
 
 template <class Graph>
-struct Counter {
+struct SampledCounter {
     using NodeId = typename Graph::NodeId;
 
     // 绑定对象
@@ -26,25 +26,25 @@ struct Counter {
     double           p;                  // 采样概率（外部采样契约）
     int              threshould;         // 几何带级阈值（避免频繁校准）
 
-    Counter()
+    SampledCounter()
       : G(nullptr), u(0), status(nullptr), priority(nullptr),
         verified_value(0), approxmt_count(0), gate(false),
         s(1), p(1.0), threshould(0) {}
 
     // 用精确初值 verified 来初始化（外部已数好，或初次计算）
-    Counter(const Graph& g,
-            NodeId u_,
-            const parlay::sequence<std::atomic<uint64_t>>* status_,
-            const parlay::sequence<double>* priority_,
-            int verified)
+    SampledCounter(const Graph& g,
+                   NodeId u_,
+                   const parlay::sequence<std::atomic<uint64_t>>* status_,
+                   const parlay::sequence<double>* priority_,
+                   int verified)
       : G(&g), u(u_), status(status_), priority(priority_),
         verified_value(verified), approxmt_count(verified), gate(false)
     {
-        s = (verified < WIDTH) ? 1 : 2 * (verified / WIDTH);
+        s = (verified < SAMPLE_WIDTH) ? 1 : 2 * (verified / SAMPLE_WIDTH);
         p = 1.0 / static_cast<double>(s);
-        int bands = verified / WIDTH;
+        int bands = verified / SAMPLE_WIDTH;
         threshould = (bands > 0)
-          ? static_cast<int>(std::bit_floor(static_cast<unsigned>(bands)) * WIDTH)
+          ? static_cast<int>(std::bit_floor(static_cast<unsigned>(bands)) * SAMPLE_WIDTH)
           : 0;
     }
 
@@ -95,17 +95,17 @@ private:
         verified_value = exact;
         approxmt_count.store(verified_value, std::memory_order_relaxed);
 
-        if (verified_value < WIDTH) {
+        if (verified_value < SAMPLE_WIDTH) {
             s = 1;
         } else {
-            s = 2 * (verified_value / WIDTH);
+            s = 2 * (verified_value / SAMPLE_WIDTH);
             if (s <= 0) s = 1;
         }
         p = (s > 0) ? (1.0 / static_cast<double>(s)) : 0.0;
 
-        int bands = verified_value / WIDTH;
+        int bands = verified_value / SAMPLE_WIDTH;
         threshould = (bands > 0)
-          ? static_cast<int>(std::bit_floor(static_cast<unsigned>(bands)) * WIDTH)
+          ? static_cast<int>(std::bit_floor(static_cast<unsigned>(bands)) * SAMPLE_WIDTH)
           : 0;
 
         if (verified_value == 0) {
@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "graph.h"
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+#include "mis.h"
+using namespace parlay;
+
+using CSRGraph = Graph<uint32_t, uint64_t>;
+using EdgeBatch = parlay::sequence<std::pair<uint32_t, uint32_t>>;
+
+// 从原图里随机抽 b 条边（删除用，可能抽到已经删掉的，那条就不算）
+EdgeBatch sample_edges(const CSRGraph& G, size_t b, uint64_t seed) {
+    return parlay::tabulate(b, [&](size_t i) {
+        uint64_t e = parlay::hash64(seed * 0x9e3779b97f4a7c15ull + i) % G.m;
+        uint32_t u = std::upper_bound(G.offsets.begin(), G.offsets.end(), e) - G.offsets.begin() - 1;
+        return std::make_pair(u, G.edges[e].v);
+    });
+}
+
+// 随机 b 个顶点对（插入用）
+EdgeBatch random_pairs(size_t n, size_t b, uint64_t seed) {
+    return parlay::tabulate(b, [&](size_t i) {
+        uint64_t h = parlay::hash64(seed * 0x9e3779b97f4a7c15ull + i);
+        return std::make_pair(static_cast<uint32_t>(h % n), static_cast<uint32_t>(parlay::hash64(h) % n));
+    });
+}
+
+// 每种批大小交替做 batches 批删除 / 插入，每批之后把当前图转成 CSR 用 par_mis 从头算一遍：
+// 既是对比的基线（recompute，不含转 CSR 的时间），也用来检查动态维护的 MIS 对不对
+int bench(const CSRGraph& G, const std::string& graphname, size_t only_batch, size_t batches, bool verify) {
+    internal::timer t;
+    DynamicMIS<uint32_t> D(G);
+    std::cout << graphname << "  n=" << G.n << " m=" << G.m << "  build " << t.next_time() << "s  |MIS| "
+              << D.mis().size() << std::endl;
+    MISWorkspace<uint32_t> ws;
+    ws.options.priority = PRIORITY_PERMUTATION;
+    MIS(G, ws);  // warm up
+    std::vector<size_t> sizes = {10, 1000, 100000};
+    if (only_batch) sizes = {only_batch};
+    uint64_t seed = 1;
+    bool all_same = true;
+    for (size_t b : sizes) {
+        if (b > G.m / 2) continue;
+        double update = 0, recompute = 0;
+        size_t changed = 0, evaluated = 0, flipped = 0, rounds = 0;
+        for (size_t k = 0; k < batches; k++, seed++) {
+            t.next_time();
+            if (k % 2 == 0) D.delete_edges(sample_edges(G, b, seed));
+            else D.insert_edges(random_pairs(G.n, b, seed));
+            update += t.next_time();
+            auto& s = D.last_batch();
+            changed += s.changed, evaluated += s.evaluated, flipped += s.flipped, rounds += s.rounds;
+            CSRGraph H = D.current_graph().to_graph();
+            t.next_time();
+            auto mis = MIS(H, ws);
+            recompute += t.next_time();
+            if (mis != D.mis()) all_same = false;
+        }
+        std::cout << "    batch " << std::setw(7) << b << "  update " << update / batches << "s  "
+                  << changed / update << " edges/s  recompute " << recompute / batches << "s  x"
+                  << recompute / update << "  per batch: evaluated " << evaluated / batches << " flipped "
+                  << flipped / batches << " rounds " << rounds / batches << std::endl;
+    }
+    std::cout << (all_same ? "all batches match recomputation" : "MISMATCH with recomputation") << std::endl;
+    if (verify) {
+        auto mis = D.mis();
+        std::filesystem::create_directories("./results");
+        std::ofstream out("./results/" + graphname + ".txt");
+        out << "# MIS size: " << mis.size() << "\n";
+        for (auto u : mis) out << u << "\n";
+    }
+    return all_same ? 0 : 1;
+}
+
+// 邻居求和：把每条边读一遍，算遍历吞吐
+template <class Graph>
+size_t sum_neighbors(const Graph& G) {
+    return parlay::reduce(parlay::delayed_seq<size_t>(G.n, [&](size_t u) {
+        size_t sum = 0;
+        G.map_neighbors(static_cast<uint32_t>(u), [&](uint32_t v) { sum += v; });
+        return sum;
+    }));
+}
+
+// --graph：DynamicGraph（dynamic_graph.h）本身的吞吐。每种批大小插入一批随机边再删掉，
+// 对比用 edgelist2graph 把原图加上这批边整个重建一遍；再比 CSR 和 DynamicGraph 上遍历邻居、跑 par_mis 的时间
+int graph_bench(const CSRGraph& G, const std::string& graphname) {
+    using Edge = CSRGraph::Edge;
+    internal::timer t;
+    DynamicGraph<uint32_t> D(G);
+    std::cout << graphname << "  n=" << G.n << " m=" << G.m << "  build " << t.next_time() << "s" << std::endl;
+    uint64_t seed = 1;
+    for (size_t b : {1000, 100000, 1000000}) {
+        if (b > G.m / 2) continue;
+        auto batch = random_pairs(G.n, b, seed++);
+        t.next_time();
+        size_t inserted = D.insert_edges(batch);
+        double insert = t.next_time();
+        size_t deleted = D.delete_edges(batch);
+        double remove = t.next_time();
+        // 重建：原图的边加上这批边的两个方向，排序建 CSR（不去重）
+        parlay::sequence<std::pair<uint32_t, Edge>> edgelist(G.m + 2 * b);
+        parlay::parallel_for(0, G.n, [&](size_t u) {
+            for (uint64_t e = G.offsets[u]; e < G.offsets[u + 1]; e++) edgelist[e] = {u, G.edges[e]};
+        });
+        parlay::parallel_for(0, b, [&](size_t i) {
+            edgelist[G.m + 2 * i] = {batch[i].first, Edge(batch[i].second, Empty())};
+            edgelist[G.m + 2 * i + 1] = {batch[i].second, Edge(batch[i].first, Empty())};
+        });
+        t.next_time();
+        auto H = edgelist2graph<uint32_t, uint64_t, Empty>(edgelist, G.n, edgelist.size());
+        double rebuild = t.next_time();
+        std::cout << "    batch " << std::setw(7) << b << "  insert " << insert << "s (" << inserted / insert
+                  << " edges/s)  delete " << remove << "s (" << deleted / remove << " edges/s)  rebuild CSR "
+                  << rebuild << "s  x" << rebuild / insert << std::endl;
+    }
+    std::cout << "    capacity " << D.capacity() << " slots for m=" << D.m << ", " << D.relayouts() << " relayouts"
+              << std::endl;
+    // 和同样内容的 CSR 比（原图可能有重边、自环，插入再删除也可能删掉原有的边）
+    CSRGraph C = D.to_graph();
+    size_t csr_sum = sum_neighbors(C), dyn_sum = sum_neighbors(D);
+    t.next_time();
+    for (int i = 0; i < 3; i++) csr_sum = sum_neighbors(C);
+    double csr_scan = t.next_time() / 3;
+    for (int i = 0; i < 3; i++) dyn_sum = sum_neighbors(D);
+    double dyn_scan = t.next_time() / 3;
+    MISWorkspace<uint32_t> ws;
+    MIS(C, ws);
+    t.next_time();
+    auto a = MIS(C, ws);
+    double csr_mis = t.next_time();
+    MIS(D, ws);
+    t.next_time();
+    auto c = MIS(D, ws);
+    double dyn_mis = t.next_time();
+    std::cout << "    scan  csr " << csr_scan << "s (" << C.m / csr_scan << " edges/s)  dynamic " << dyn_scan << "s ("
+              << D.m / dyn_scan << " edges/s)" << (csr_sum == dyn_sum ? "" : "  (SUM DIFFERS)") << "\n"
+              << "    mis   csr " << csr_mis << "s  dynamic " << dyn_mis << "s" << (a == c ? "" : "  (MIS DIFFERS)")
+              << std::endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 5) {
+        std::cerr << "Usage: ./mis input_graph [batch_size] [batches] [verify]\n"
+                  << "       ./mis input_graph --graph   (DynamicGraph update / scan throughput vs CSR)\n"
+                  << "batch_size 0 (default) runs 10, 1000 and 100000; batches (default 6) alternate deletions\n"
+                  << "of sampled edges and insertions of random pairs; verify writes the final MIS to ./results"
+                  << std::endl;
+        return 1;
+    }
+    const char* filename = argv[1];
+    std::string mode = argc >= 3 ? argv[2] : "";
+    size_t batch = argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 0;
+    size_t batches = argc >= 4 ? std::max<size_t>(1, std::strtoull(argv[3], nullptr, 10)) : 6;
+    bool verify = argc == 5 && std::atoi(argv[4]) != 0;
+    CSRGraph G;
+    G.read_graph(filename);
+    if (!G.symmetrized) {
+        G = make_symmetrized(G);
+    }
+    std::string graphname = std::filesystem::path(filename).stem().string();
+    if (mode == "--graph") return graph_bench(G, graphname);
+    return bench(G, graphname, batch, batches, verify);
+}
@@ -0,0 +1,140 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+#include "counter.h"
+#include "dynamic_graph.h"
+#include "par_mis/mis.h"
+#include "priority.h"
+
+// 批量动态 MIS：优先级（seed 生成的随机排列，和 par_mis MIS_PRIORITY=perm 同一个）固定不变，
+// 一批一批地插入 / 删除边，始终维护字典序最小的 MIS。
+//
+// 每个顶点一个 Counter blockers[u] = 比 u 优先级高、并且在 MIS 里的邻居个数，
+// 不变式是 u 在 MIS 里 ⇔ blockers[u] 为 0（初始状态由 par_mis 算出来）。
+// 一条边 (u, v)（u 优先级高）的插入 / 删除只在 u 在 MIS 里时改 blockers[v]，v 进 pending；
+// 之后按轮修复：pending 里没有更高优先级的 pending 邻居的顶点这一轮决定，
+// 状态和不变式不符的翻转，翻转的顶点给低优先级邻居的 blockers 加一 / 减一，这些邻居进下一轮 pending。
+// 状态只往低优先级方向传，优先级最高的 pending 顶点每轮都能决定，所以一定收敛；
+// 收敛时不变式处处成立，满足它的只有字典序最小的 MIS。只有受影响的区域被访问。
+//
+// 图存在 DynamicGraph（见 dynamic_graph.h）里，一批更新按源顶点分组后每个顶点一个任务原地合并。
+template <class NodeId>
+class DynamicMIS {
+ public:
+  // 上一批更新的统计
+  struct BatchStats {
+    size_t changed = 0;    // 真正改变了图的边数（已存在的插入、不存在的删除不算）
+    size_t evaluated = 0;  // 修复时重新判断过的顶点数
+    size_t flipped = 0;    // 状态翻转的次数
+    size_t rounds = 0;     // 修复的轮数
+  };
+
+  template <class Graph>
+  DynamicMIS(const Graph &G, size_t seed = 0)
+      : n(G.n), graph(G), rank(G.n), in_mis(G.n, 0), blockers(G.n), pending(G.n), waiting(G.n, G.n) {
+    parlay::parallel_for(0, n, [&](size_t u) { pending[u].store(0, std::memory_order_relaxed); });
+    stored_ranks(G, PRIORITY_PERMUTATION, seed, rank.begin());
+    MISWorkspace<NodeId> ws;
+    ws.options.priority = PRIORITY_PERMUTATION;
+    auto mis = MIS(G, ws, seed);
+    parlay::parallel_for(0, mis.size(), [&](size_t i) { in_mis[mis[i]] = 1; });
+    parlay::parallel_for(0, n, [&](size_t u) {
+      int count = 0;
+      graph.map_neighbors(u, [&](NodeId v) { count += in_mis[v] && rank[v] < rank[u]; });
+      blockers[u].reset(count);
+    });
+  }
+
+  const DynamicGraph<NodeId> &current_graph() const { return graph; }
+  const BatchStats &last_batch() const { return stats; }
+
+  // 无向边批量插入 / 删除（自环和越界的忽略，重复的只算一次），返回后 mis() 就是新图的答案
+  void insert_edges(const parlay::sequence<std::pair<NodeId, NodeId>> &batch) { update(batch, true); }
+  void delete_edges(const parlay::sequence<std::pair<NodeId, NodeId>> &batch) { update(batch, false); }
+
+  parlay::sequence<NodeId> mis() const {
+    return parlay::filter(parlay::iota<NodeId>(n), [&](NodeId u) { return in_mis[u] != 0; });
+  }
+
+ private:
+  void update(const parlay::sequence<std::pair<NodeId, NodeId>> &batch, bool insert) {
+    stats = BatchStats();
+    // 只在 t 优先级高并且在 MIS 里时改 blockers[s]；同一个 s 的回调不会并发
+    auto on_change = [&](NodeId s, NodeId t) {
+      if (!in_mis[t] || rank[s] < rank[t]) return;
+      if (insert) blockers[s].increment();
+      else blockers[s].decrement();
+      pending[s].store(1, std::memory_order_relaxed);
+    };
+    stats.changed = insert ? graph.insert_edges(batch, on_change) : graph.delete_edges(batch, on_change);
+    auto ends = parlay::sort(parlay::delayed_seq<NodeId>(2 * batch.size(), [&](size_t i) {
+      return i % 2 ? batch[i / 2].second : batch[i / 2].first;
+    }));
+    auto dirty = parlay::filter(parlay::unique(ends), [&](NodeId u) {
+      return u < n && pending[u].load(std::memory_order_relaxed) != 0;
+    });
+    repair(std::move(dirty));
+  }
+
+  // 从 pending 的顶点开始，把状态变化往低优先级方向传，直到没有 pending
+  void repair(parlay::sequence<NodeId> frontier) {
+    while (!frontier.empty()) {
+      stats.rounds++;
+      // 上一轮挡住 u 的邻居记在 waiting[u]，它还 pending 就不用再扫一遍邻接表
+      auto ready = parlay::tabulate(frontier.size(), [&](size_t i) {
+        NodeId u = frontier[i], w = waiting[u];
+        if (w < n && pending[w].load(std::memory_order_relaxed)) return false;
+        for (NodeId v : graph.neighbors(u)) {
+          if (rank[v] < rank[u] && pending[v].load(std::memory_order_relaxed)) {
+            waiting[u] = v;
+            return false;
+          }
+        }
+        return true;
+      });
+      auto decide = parlay::pack(frontier, ready);
+      auto deferred = parlay::pack(frontier, parlay::delayed_seq<bool>(frontier.size(), [&](size_t i) {
+        return !ready[i];
+      }));
+      stats.evaluated += decide.size();
+      parlay::parallel_for(0, decide.size(), [&](size_t i) {
+        pending[decide[i]].store(0, std::memory_order_relaxed);
+        waiting[decide[i]] = n;  // 下一批边变了，旧的记录就不一定是邻居了
+      });
+      auto flip = parlay::filter(decide, [&](NodeId u) {
+        return blockers[u].is_zero() != static_cast<bool>(in_mis[u]);
+      });
+      stats.flipped += flip.size();
+      parlay::parallel_for(0, flip.size(), [&](size_t i) { in_mis[flip[i]] ^= 1; });
+      // 翻转的顶点都没有 pending 的高优先级邻居，所以它们互相不会推到对方
+      auto pushed = parlay::tabulate(flip.size(), [&](size_t i) {
+        NodeId u = flip[i];
+        std::vector<NodeId> out;
+        graph.map_neighbors(u, [&](NodeId w) {
+          if (rank[w] < rank[u]) return;
+          if (in_mis[u]) blockers[w].increment();
+          else blockers[w].decrement();
+          if (pending[w].exchange(1, std::memory_order_relaxed) == 0) out.push_back(w);
+        });
+        return out;
+      });
+      frontier = parlay::append(deferred, parlay::flatten(pushed));
+    }
+  }
+
+  size_t n;
+  DynamicGraph<NodeId> graph;
+  parlay::sequence<NodeId> rank;
+  parlay::sequence<uint8_t> in_mis;
+  parlay::sequence<Counter> blockers;
+  parlay::sequence<std::atomic<uint8_t>> pending;
+  parlay::sequence<NodeId> waiting;  // 挡住 pending 顶点的高优先级 pending 邻居（n 表示没有）
+  BatchStats stats;
+};
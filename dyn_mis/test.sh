@@ -0,0 +1,5 @@
+make clean
+make
+./mis ../testcases/bin/friendster_sym.bin
+#./mis ../testcases/bin/soc-LiveJournal1_sym.bin 1000 10 1
+#./mis ../testcases/bin/soc-LiveJournal1_sym.bin --graph
@@ -0,0 +1,237 @@
+#ifndef DYNAMIC_GRAPH_H
+#define DYNAMIC_GRAPH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+
+// A symmetric graph that takes batches of edge insertions and deletions.
+// Graph in graph.h is a packed CSR, so adding an edge means rebuilding it
+// (edgelist2graph sorts the whole edge list). Here every vertex gets a
+// sorted neighbor list in a CSR-like array with some slack behind it:
+// capacity = degree + max(kMinSlack, degree / kSlackDivisor). A batch is
+// grouped by source vertex and each touched list is merged in place by
+// its own task; only when a list outgrows its slot is the array laid out
+// again, with fresh slack for the grown lists. Neighbor iteration stays a
+// scan of one contiguous run, and degree / map_neighbors have the same
+// shape as Graph, so the MIS engines run on it directly.
+constexpr size_t kMinSlack = 2;
+constexpr size_t kSlackDivisor = 4;
+
+template <class _NodeId = uint32_t>
+class DynamicGraph {
+ public:
+  using NodeId = _NodeId;
+  using EdgeId = uint64_t;
+  using EdgeBatch = parlay::sequence<std::pair<NodeId, NodeId>>;
+
+  size_t n = 0;
+  size_t m = 0;  // directed entries, 2x the undirected edges (as in Graph)
+
+  DynamicGraph() = default;
+
+  // Self loops and duplicate entries of G are dropped. G should be
+  // symmetric.
+  template <class Graph>
+  explicit DynamicGraph(const Graph &G) : n(G.n) {
+    auto lists = parlay::tabulate(n, [&](size_t u) {
+      std::vector<NodeId> list;
+      list.reserve(G.degree(static_cast<NodeId>(u)));
+      G.map_neighbors(static_cast<NodeId>(u), [&](NodeId v) {
+        if (v != u) list.push_back(v);
+      });
+      std::sort(list.begin(), list.end());
+      list.erase(std::unique(list.begin(), list.end()), list.end());
+      return list;
+    });
+    size_ = parlay::tabulate(n, [&](size_t u) { return static_cast<NodeId>(lists[u].size()); });
+    m = parlay::reduce(parlay::delayed_seq<size_t>(n, [&](size_t u) { return lists[u].size(); }));
+    layout([&](size_t u) { return capacity_for(lists[u].size()); },
+           [&](size_t u, NodeId *out) { std::copy(lists[u].begin(), lists[u].end(), out); });
+  }
+
+  size_t degree(NodeId u) const { return size_[u]; }
+
+  template <class F>
+  void map_neighbors(NodeId u, F &&f) const {
+    const NodeId *p = slots_.begin() + start_[u];
+    const NodeId *end = p + size_[u];
+    for (; p != end; p++) f(*p);
+  }
+
+  // Sorted neighbors of u; invalidated by the next batch.
+  auto neighbors(NodeId u) const { return slots_.cut(start_[u], start_[u] + size_[u]); }
+
+  // Slots allocated, used or not, and how many times the array was laid
+  // out again because a list outgrew its slot.
+  size_t capacity() const { return slots_.size(); }
+  size_t relayouts() const { return relayouts_; }
+  // Batches that changed at least one edge; caches keyed on the graph
+  // (GraphKey in priority.h) compare it.
+  size_t version() const { return version_; }
+
+  // Undirected edge batches. Self loops and out-of-range endpoints are
+  // ignored, as are insertions of present edges and deletions of absent
+  // ones. on_change(s, t) runs once for each direction of every edge that
+  // did change, from the task that owns s's list (so never concurrently
+  // for the same s). Return the number of undirected edges changed.
+  template <class F>
+  size_t insert_edges(const EdgeBatch &batch, F &&on_change) {
+    return update(batch, true, on_change);
+  }
+  template <class F>
+  size_t delete_edges(const EdgeBatch &batch, F &&on_change) {
+    return update(batch, false, on_change);
+  }
+  size_t insert_edges(const EdgeBatch &batch) {
+    return update(batch, true, [](NodeId, NodeId) {});
+  }
+  size_t delete_edges(const EdgeBatch &batch) {
+    return update(batch, false, [](NodeId, NodeId) {});
+  }
+
+  // Packed CSR copy of the current graph.
+  Graph<NodeId, uint64_t> to_graph() const {
+    using Edge = typename Graph<NodeId, uint64_t>::Edge;
+    Graph<NodeId, uint64_t> G;
+    G.n = n;
+    G.m = m;
+    G.symmetrized = true;
+    G.weighted = false;
+    G.offsets = parlay::sequence<uint64_t>(n + 1, 0);
+    parlay::parallel_for(0, n, [&](size_t u) { G.offsets[u] = size_[u]; });
+    parlay::scan_inplace(G.offsets);
+    G.edges = parlay::sequence<Edge>::uninitialized(m);
+    parlay::parallel_for(0, n, [&](size_t u) {
+      const NodeId *p = slots_.begin() + start_[u];
+      for (size_t i = 0; i < size_[u]; i++) G.edges[G.offsets[u] + i] = Edge(p[i], Empty());
+    });
+    return G;
+  }
+
+ private:
+  static size_t capacity_for(size_t degree) {
+    return degree + std::max(kMinSlack, degree / kSlackDivisor);
+  }
+
+  // New array with cap(u) slots for vertex u; fill(u, out) writes u's
+  // size_[u] neighbors.
+  template <class Cap, class Fill>
+  void layout(Cap &&cap, Fill &&fill) {
+    auto start = parlay::sequence<EdgeId>::uninitialized(n + 1);
+    parlay::parallel_for(0, n, [&](size_t u) { start[u] = cap(u); });
+    start[n] = 0;
+    EdgeId total = parlay::scan_inplace(start.cut(0, n));
+    start[n] = total;
+    auto slots = parlay::sequence<NodeId>::uninitialized(total);
+    parlay::parallel_for(0, n, [&](size_t u) { fill(u, slots.begin() + start[u]); });
+    start_ = std::move(start);
+    slots_ = std::move(slots);
+  }
+
+  template <class F>
+  size_t update(const EdgeBatch &batch, bool insert, F &&on_change) {
+    // Both directions, sorted by (source, target) without duplicates; one
+    // group per source vertex.
+    auto valid = parlay::filter(batch, [&](const std::pair<NodeId, NodeId> &e) {
+      return e.first != e.second && e.first < n && e.second < n;
+    });
+    auto directed = EdgeBatch::uninitialized(2 * valid.size());
+    parlay::parallel_for(0, valid.size(), [&](size_t i) {
+      directed[2 * i] = valid[i];
+      directed[2 * i + 1] = {valid[i].second, valid[i].first};
+    });
+    parlay::sort_inplace(directed);
+    directed = parlay::unique(directed);
+    auto starts = parlay::filter(parlay::iota<size_t>(directed.size()), [&](size_t i) {
+      return i == 0 || directed[i].first != directed[i - 1].first;
+    });
+    size_t groups = starts.size();
+    // Lists that no longer fit their slot are built here and placed by a
+    // relayout afterwards.
+    parlay::sequence<std::vector<NodeId>> grown(groups);
+    auto changed = parlay::tabulate(groups, [&](size_t g) {
+      size_t lo = starts[g], hi = g + 1 < groups ? starts[g + 1] : directed.size();
+      NodeId s = directed[lo].first;
+      NodeId *list = slots_.begin() + start_[s];
+      size_t size = size_[s], cap = start_[s + 1] - start_[s];
+      if (!insert) {
+        // Two-pointer filter, compacting in place.
+        size_t out = 0, j = lo;
+        for (size_t i = 0; i < size; i++) {
+          while (j < hi && directed[j].second < list[i]) j++;
+          if (j < hi && directed[j].second == list[i]) {
+            on_change(s, list[i]);
+          } else {
+            list[out++] = list[i];
+          }
+        }
+        size_[s] = out;
+        return size - out;
+      }
+      std::vector<NodeId> add;
+      for (size_t i = 0, j = lo; j < hi; j++) {
+        NodeId t = directed[j].second;
+        while (i < size && list[i] < t) i++;
+        if (i < size && list[i] == t) continue;
+        add.push_back(t);
+        on_change(s, t);
+      }
+      size_t k = add.size(), total = size + k;
+      if (total > cap) {
+        std::vector<NodeId> &merged = grown[g];
+        merged.resize(total);
+        std::merge(list, list + size, add.begin(), add.end(), merged.begin());
+      } else {
+        // Merge from the back so nothing is overwritten before it is read.
+        size_t i = size, j = k, out = total;
+        while (j > 0) {
+          if (i > 0 && list[i - 1] > add[j - 1]) list[--out] = list[--i];
+          else list[--out] = add[--j];
+        }
+      }
+      size_[s] = total;
+      return k;
+    });
+    size_t count = parlay::reduce(changed);
+    auto overflow = parlay::filter(parlay::iota<size_t>(groups), [&](size_t g) { return !grown[g].empty(); });
+    if (!overflow.empty()) {
+      relayouts_++;
+      constexpr size_t kStays = SIZE_MAX;
+      parlay::sequence<size_t> where(n, kStays);  // group holding the grown list
+      parlay::parallel_for(0, overflow.size(), [&](size_t i) {
+        where[directed[starts[overflow[i]]].first] = overflow[i];
+      });
+      auto old_start = std::move(start_);
+      auto old_slots = std::move(slots_);
+      layout(
+          [&](size_t u) {
+            return where[u] == kStays ? old_start[u + 1] - old_start[u] : capacity_for(size_[u]);
+          },
+          [&](size_t u, NodeId *out) {
+            if (where[u] == kStays) {
+              std::copy(old_slots.begin() + old_start[u], old_slots.begin() + old_start[u] + size_[u], out);
+            } else {
+              std::copy(grown[where[u]].begin(), grown[where[u]].end(), out);
+            }
+          });
+    }
+    if (insert) m += count;
+    else m -= count;
+    if (count) version_++;
+    return count / 2;
+  }
+
+  parlay::sequence<EdgeId> start_ = parlay::sequence<EdgeId>(1, 0);  // slot of u: [start_[u], start_[u + 1])
+  parlay::sequence<NodeId> size_;                                    // neighbors of u in use
+  parlay::sequence<NodeId> slots_;
+  size_t relayouts_ = 0;
+  size_t version_ = 0;
+};
+
+#endif  // DYNAMIC_GRAPH_H
@@ -0,0 +1,182 @@
+#pragma once
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "perf_counters.h"
+
+// Reads a byte range of a file front to back as a stream of T, in blocks of
+// block_bytes. Two buffers: while the caller consumes one, a helper thread
+// preads the next, so the disk stays busy during processing. The range
+// start must be T-aligned relative to the file (it is for every region of
+// the .bin layout).
+template <class T>
+class BlockStream {
+ public:
+  BlockStream(int fd, size_t begin, size_t end, size_t block_bytes)
+      : fd(fd), next_off(begin), end(end) {
+    block = std::max(sizeof(T), block_bytes / sizeof(T) * sizeof(T));
+    buf[0].resize(block / sizeof(T));
+    buf[1].resize(block / sizeof(T));
+    if (begin < end) {
+      fill(1);
+      swap_in();
+    }
+  }
+
+  ~BlockStream() {
+    if (reader.joinable()) reader.join();
+  }
+
+  BlockStream(const BlockStream &) = delete;
+  BlockStream &operator=(const BlockStream &) = delete;
+
+  T next() {
+    if (pos == len) swap_in();
+    return cur[pos++];
+  }
+
+  size_t bytes_read() const { return total; }
+
+ private:
+  // Starts reading the next block into buf[b] on the helper thread.
+  void fill(int b) {
+    size_t bytes = std::min(block, end - next_off);
+    size_t off = next_off;
+    next_off += bytes;
+    filled[b] = bytes / sizeof(T);
+    reader = std::thread([this, b, off, bytes] {
+      char *out = reinterpret_cast<char *>(buf[b].data());
+      size_t done = 0;
+      while (done < bytes) {
+        ssize_t r = pread(fd, out + done, bytes - done, off + done);
+        if (r <= 0) {
+          std::cerr << "Error: pread failed at offset " << off + done << ": "
+                    << std::strerror(r == 0 ? EIO : errno) << std::endl;
+          abort();
+        }
+        done += r;
+      }
+    });
+  }
+
+  // Waits for the block in flight, makes it current, and starts the next.
+  // Empty ranges never get here: next() is only called for elements that
+  // exist.
+  void swap_in() {
+    if (reader.joinable()) reader.join();
+    int b = loading;
+    if (filled[b] == 0) {
+      std::cerr << "Error: read past the end of the stream" << std::endl;
+      abort();
+    }
+    cur = buf[b].data();
+    len = filled[b];
+    pos = 0;
+    total += len * sizeof(T);
+    loading = 1 - b;
+    if (next_off < end) {
+      fill(loading);
+    } else {
+      filled[loading] = 0;
+    }
+  }
+
+  int fd;
+  size_t next_off, end, block;
+  std::vector<T> buf[2];
+  size_t filled[2] = {0, 0};
+  int loading = 1;
+  std::thread reader;
+  const T *cur = nullptr;
+  size_t len = 0, pos = 0;
+  size_t total = 0;
+};
+
+struct ExternalMISResult {
+  size_t n = 0, m = 0;
+  std::vector<uint64_t> in_mis;  // bitset, bit u set if u is in the MIS
+  size_t size = 0;
+  size_t bytes_read = 0;
+  size_t resident_bytes = 0;  // bitsets plus stream buffers
+
+  bool contains(size_t u) const { return (in_mis[u / 64] >> (u % 64)) & 1; }
+};
+
+// Semi-external greedy MIS over a symmetric .bin graph
+// ([n][m][sizes][offsets (n+1)][edges m], 64-bit header and offsets,
+// 32-bit edges). Vertices are taken in ID order, so offsets and edges are
+// each read once, sequentially, in blocks of block_bytes; only two bits
+// per vertex (in_mis, removed) stay in memory. The priority order is the
+// ID order of the file. For a random order, relabel the file first with
+// tools/reorder random <seed>: the result is then the MIS that par_mis
+// (perm priority) computes with that seed, in the new ids.
+inline ExternalMISResult ExternalMIS(const char *filename,
+                                     size_t block_bytes = size_t(64) << 20,
+                                     PhaseProfile *prof = nullptr) {
+  if (prof) prof->start();
+  int fd = open(filename, O_RDONLY);
+  if (fd == -1) {
+    std::cerr << "Error: Cannot open file " << filename << std::endl;
+    abort();
+  }
+  struct stat sb;
+  if (fstat(fd, &sb) == -1) {
+    std::cerr << "Error: Unable to acquire file stat" << std::endl;
+    abort();
+  }
+  uint64_t header[3];
+  if (pread(fd, header, sizeof(header), 0) != sizeof(header)) {
+    std::cerr << "Error: Cannot read header of " << filename << std::endl;
+    abort();
+  }
+  ExternalMISResult res;
+  res.n = header[0];
+  res.m = header[1];
+  size_t offsets_begin = sizeof(header);
+  size_t edges_begin = offsets_begin + (res.n + 1) * sizeof(uint64_t);
+  size_t edges_end = edges_begin + res.m * sizeof(uint32_t);
+  if (header[2] != edges_end || static_cast<size_t>(sb.st_size) != edges_end) {
+    std::cerr << "Error: Bad input graph" << std::endl;
+    abort();
+  }
+  posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+  size_t words = (res.n + 63) / 64;
+  res.in_mis.assign(words, 0);
+  std::vector<uint64_t> removed(words, 0);
+  BlockStream<uint64_t> offsets(fd, offsets_begin, edges_begin, block_bytes);
+  BlockStream<uint32_t> edges(fd, edges_begin, edges_end, block_bytes);
+  res.resident_bytes = 2 * words * sizeof(uint64_t) + 4 * block_bytes;
+  if (prof) prof->lap("init");
+
+  uint64_t lo = offsets.next();
+  for (size_t u = 0; u < res.n; u++) {
+    uint64_t hi = offsets.next();
+    bool take = !((removed[u / 64] >> (u % 64)) & 1);
+    if (take) {
+      res.in_mis[u / 64] |= uint64_t(1) << (u % 64);
+      res.size++;
+    }
+    // The edges of a removed vertex are still read (and dropped) to keep
+    // the stream sequential.
+    for (uint64_t e = lo; e < hi; e++) {
+      uint32_t v = edges.next();
+      if (take) removed[v / 64] |= uint64_t(1) << (v % 64);
+    }
+    lo = hi;
+  }
+  if (prof) prof->lap("stream");
+  res.bytes_read = sizeof(header) + offsets.bytes_read() + edges.bytes_read();
+  close(fd);
+  return res;
+}
@@ -0,0 +1,5 @@
+make clean
+make
+./mis ../testcases/bin/friendster_sym.bin 1
+#./mis ../testcases/bin/hyperlink2012_sym.bin 0 256
+#../tools/reorder ../testcases/bin/friendster_sym.bin random ../testcases/bin/friendster_r1_sym.bin 1 && ./mis ../testcases/bin/friendster_r1_sym.bin 1
\ No newline at end of file
@@ -8,8 +8,12 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cerrno>
+#include <cstring>
 #include <fstream>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -17,10 +21,58 @@
 #include "external/parlaylib/include/parlay/parallel.h"
 #include "external/parlaylib/include/parlay/sequence.h"
 #include "external/parlaylib/include/parlay/utilities.h"
+#include "alloc_policy.h"
 #include "utils.h"
 
 class Empty {};
 
+// SWAR helpers for the chunked text parser. A "word" is 8 bytes loaded
+// little-endian, so the first character is the lowest byte.
+inline bool is_graph_space(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' ||
+         c == '\f';
+}
+
+// Number of leading decimal digits in the 8 bytes at p (0..8).
+inline size_t swar_digit_count(uint64_t word) {
+  uint64_t t = ((word & 0xF0F0F0F0F0F0F0F0ull) |
+                (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >>
+                 4)) ^
+               0x3333333333333333ull;
+  return t ? __builtin_ctzll(t) / 8 : 8;
+}
+
+// Value of the first len (1..8) digits of word.
+inline uint64_t swar_parse_digits(uint64_t word, size_t len) {
+  word -= 0x3030303030303030ull;
+  word <<= 8 * (8 - len);  // left-pad with zero digits
+  word = word * 10 + (word >> 8);
+  word = (((word & 0x000000FF000000FFull) * 0x000F424000000064ull) +
+          (((word >> 16) & 0x000000FF000000FFull) * 0x0000271000000001ull)) >>
+         32;
+  return word;
+}
+
+// Parses the unsigned integer starting at p (p < end points to a digit),
+// advancing p past it. Uses 8-byte loads while they stay inside [p, end).
+inline uint64_t parse_uint_swar(const char *&p, const char *end) {
+  static constexpr uint64_t kPow10[9] = {1,      10,      100,
+                                         1000,   10000,   100000,
+                                         1000000, 10000000, 100000000};
+  uint64_t v = 0;
+  while (p + 8 <= end) {
+    uint64_t word;
+    std::memcpy(&word, p, 8);
+    size_t len = swar_digit_count(word);
+    if (len == 0) return v;
+    v = v * kPow10[len] + swar_parse_digits(word, len);
+    p += len;
+    if (len < 8) return v;
+  }
+  while (p < end && *p >= '0' && *p <= '9') v = v * 10 + (*p++ - '0');
+  return v;
+}
+
 template <class NodeId, class EdgeTy>
 class WEdge {
  public:
@@ -50,6 +102,33 @@ class WEdge {
   }
 };
 
+// Reads bytes [file_offset, file_offset + bytes) of fd into dst with one
+// pread per chunk, chunks issued in parallel. Chunk boundaries are aligned
+// to chunk_size in file coordinates so every request but the first and
+// last is a full aligned block.
+inline void pread_parallel(int fd, void *dst, size_t bytes, size_t file_offset,
+                           size_t chunk_size) {
+  if (bytes == 0) return;
+  chunk_size = std::max<size_t>(4096, chunk_size & ~size_t(4095));
+  size_t first = file_offset / chunk_size;
+  size_t last = (file_offset + bytes - 1) / chunk_size;
+  parlay::parallel_for(first, last + 1, [&](size_t c) {
+    size_t lo = std::max(c * chunk_size, file_offset);
+    size_t hi = std::min((c + 1) * chunk_size, file_offset + bytes);
+    char *out = static_cast<char *>(dst) + (lo - file_offset);
+    while (lo < hi) {
+      ssize_t r = pread(fd, out, hi - lo, lo);
+      if (r <= 0) {
+        std::cerr << "Error: pread failed at offset " << lo << ": "
+                  << std::strerror(r == 0 ? EIO : errno) << std::endl;
+        abort();
+      }
+      lo += r;
+      out += r;
+    }
+  }, 1);
+}
+
 template <class _NodeId = uint32_t, class _EdgeId = uint64_t,
           class _EdgeTy = Empty>
 class Graph {
@@ -67,6 +146,19 @@ class Graph {
   parlay::sequence<Edge> edges;
   parlay::sequence<EdgeId> in_offsets;
   parlay::sequence<Edge> in_edges;
+  // Request size used by the pread-based binary loaders.
+  size_t io_chunk_size = size_t(64) << 20;
+
+  size_t degree(NodeId u) const { return offsets[u + 1] - offsets[u]; }
+
+  // Calls f(v) for every out-neighbor v of u. Implicit graphs
+  // (implicit_graph.h) provide the same two members.
+  template <class F>
+  void map_neighbors(NodeId u, F &&f) const {
+    for (EdgeId e = offsets[u]; e < offsets[u + 1]; e++) {
+      f(edges[e].v);
+    }
+  }
 
   auto in_neighors(NodeId u) const {
     if (symmetrized) {
@@ -152,6 +244,124 @@ class Graph {
     }
   }
 
+  // Same format as read_pbbs_format, parsed straight from an mmap of the
+  // file: the file is cut into ~chunk_size pieces at whitespace boundaries,
+  // one pass counts the tokens of every chunk, and after a scan each chunk
+  // converts its tokens with parse_uint_swar into offsets/edges directly.
+  // Peak memory is the graph itself plus the page cache.
+  void read_pbbs_format_chunked(char const *filename,
+                                size_t chunk_size = (1 << 20)) {
+    struct stat sb;
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+      std::cerr << "Error: Cannot open file " << filename << std::endl;
+      abort();
+    }
+    if (fstat(fd, &sb) == -1) {
+      std::cerr << "Error: Unable to acquire file stat" << std::endl;
+      abort();
+    }
+    size_t len = sb.st_size;
+    const char *data = static_cast<const char *>(
+        mmap(0, len, PROT_READ, MAP_PRIVATE, fd, 0));
+    close(fd);
+    if (data == MAP_FAILED) {
+      std::cerr << "Error: Cannot mmap file " << filename << std::endl;
+      abort();
+    }
+    const char *end = data + len;
+
+    // Header: name, n, m
+    const char *p = data;
+    while (p < end && is_graph_space(*p)) p++;
+    const char *name = p;
+    while (p < end && !is_graph_space(*p)) p++;
+    std::string header(name, p);
+    bool weighted_input;
+    if (header == "WeightedAdjacencyGraph") {
+      weighted_input = true;
+    } else if (header == "AdjacencyGraph") {
+      weighted_input = false;
+    } else {
+      std::cerr << "Unrecognized header" << std::endl;
+      abort();
+    }
+    while (p < end && is_graph_space(*p)) p++;
+    n = parse_uint_swar(p, end);
+    while (p < end && is_graph_space(*p)) p++;
+    m = parse_uint_swar(p, end);
+    size_t body = p - data;
+    size_t num_tokens = n + m + (weighted_input ? m : 0);
+
+    // Chunk i covers [cut[i], cut[i + 1]); every cut except the first sits
+    // on a whitespace byte so no token straddles two chunks.
+    size_t num_chunks = std::max<size_t>(1, (len - body) / chunk_size);
+    parlay::sequence<size_t> cut(num_chunks + 1);
+    parlay::parallel_for(0, num_chunks + 1, [&](size_t i) {
+      if (i == 0) {
+        cut[i] = body;
+      } else if (i == num_chunks) {
+        cut[i] = len;
+      } else {
+        size_t j = body + i * chunk_size;
+        while (j < len && !is_graph_space(data[j])) j++;
+        cut[i] = j;
+      }
+    });
+    parlay::sequence<size_t> first_token(num_chunks + 1);
+    parlay::parallel_for(0, num_chunks, [&](size_t i) {
+      size_t count = 0;
+      bool prev_space = true;
+      for (size_t j = cut[i]; j < cut[i + 1]; j++) {
+        bool space = is_graph_space(data[j]);
+        count += prev_space && !space;
+        prev_space = space;
+      }
+      first_token[i] = count;
+    }, 1);
+    first_token[num_chunks] = 0;
+    size_t total = parlay::scan_inplace(first_token);
+    if (total != num_tokens) {
+      std::cerr << "Error: Bad input graph, expected " << num_tokens
+                << " tokens after the header but found " << total << std::endl;
+      abort();
+    }
+
+    offsets = parlay::sequence<EdgeId>::uninitialized(n + 1);
+    edges = parlay::sequence<Edge>::uninitialized(m);
+    if (weighted_input && std::is_same_v<EdgeTy, Empty>) {
+      std::cout << "Warning: skipping edge weights in file" << std::endl;
+    }
+    weighted = weighted_input && !std::is_same_v<EdgeTy, Empty>;
+    parlay::parallel_for(0, num_chunks, [&](size_t i) {
+      const char *q = data + cut[i];
+      const char *chunk_end = data + cut[i + 1];
+      for (size_t k = first_token[i];; k++) {
+        while (q < chunk_end && is_graph_space(*q)) q++;
+        if (q == chunk_end) break;
+        if (k < n) {
+          offsets[k] = parse_uint_swar(q, chunk_end);
+        } else if (k < n + m) {
+          edges[k - n].v = parse_uint_swar(q, chunk_end);
+        } else if constexpr (std::is_integral_v<EdgeTy>) {
+          bool neg = (*q == '-');
+          if (neg) q++;
+          EdgeTy w = parse_uint_swar(q, chunk_end);
+          edges[k - n - m].w = neg ? -w : w;
+        } else if constexpr (std::is_floating_point_v<EdgeTy>) {
+          char buf[64];
+          size_t l = 0;
+          while (q < chunk_end && !is_graph_space(*q) && l < 63) buf[l++] = *q++;
+          buf[l] = '\0';
+          edges[k - n - m].w = std::strtod(buf, nullptr);
+        }
+        while (q < chunk_end && !is_graph_space(*q)) q++;
+      }
+    }, 1);
+    offsets[n] = m;
+    munmap(const_cast<char *>(data), len);
+  }
+
   void read_binary_format(char const *filename) {
     // Uses mmap to accelerate reading
     struct stat sb;
@@ -215,11 +425,78 @@ class Graph {
     ifs.close();
   }
 
+  // Reads one CSR block of the binary layout ([n][m][sizes][offsets][edges])
+  // starting at file position pos with parallel preads directly into the
+  // destination sequences; returns the position just past the block.
+  size_t pread_csr_block(int fd, size_t pos, parlay::sequence<EdgeId> &offs,
+                         parlay::sequence<Edge> &adj) {
+    uint64_t header[3];
+    pread_parallel(fd, header, sizeof(header), pos, io_chunk_size);
+    n = header[0];
+    m = header[1];
+    assert(header[2] == (n + 1) * 8 + m * 4 + 3 * 8);
+    pos += sizeof(header);
+    offs = parlay::sequence<EdgeId>::uninitialized(n + 1);
+    adj = parlay::sequence<Edge>::uninitialized(m);
+    // THP / NUMA interleave (MIS_PAGES, MIS_NUMA) before the pages are touched
+    AllocPolicy policy = AllocPolicy::from_env();
+    advise_alloc_policy(offs.begin(), (n + 1) * sizeof(EdgeId), policy);
+    advise_alloc_policy(adj.begin(), m * sizeof(Edge), policy);
+    if constexpr (sizeof(EdgeId) == sizeof(uint64_t)) {
+      pread_parallel(fd, offs.begin(), (n + 1) * 8, pos, io_chunk_size);
+    } else {
+      auto tmp = parlay::sequence<uint64_t>::uninitialized(n + 1);
+      pread_parallel(fd, tmp.begin(), (n + 1) * 8, pos, io_chunk_size);
+      parlay::parallel_for(0, n + 1, [&](size_t i) { offs[i] = tmp[i]; });
+    }
+    pos += (n + 1) * 8;
+    if constexpr (sizeof(Edge) == sizeof(uint32_t)) {
+      pread_parallel(fd, adj.begin(), m * 4, pos, io_chunk_size);
+    } else {
+      auto tmp = parlay::sequence<uint32_t>::uninitialized(m);
+      pread_parallel(fd, tmp.begin(), m * 4, pos, io_chunk_size);
+      parlay::parallel_for(0, m, [&](size_t i) { adj[i].v = tmp[i]; });
+    }
+    return pos + m * 4;
+  }
+
+  // Same result as read_binary_format / read_hyperlink2012, but the file is
+  // pulled in by many threads issuing io_chunk_size preads.
+  void read_binary_format_pread(char const *filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+      std::cerr << "Error: Cannot open file " << filename << std::endl;
+      abort();
+    }
+    pread_csr_block(fd, 0, offsets, edges);
+    close(fd);
+  }
+
+  void read_hyperlink2012_pread(char const *filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+      std::cerr << "Error: Cannot open file " << filename << std::endl;
+      abort();
+    }
+    struct stat sb;
+    if (fstat(fd, &sb) == -1) {
+      std::cerr << "Error: Unable to acquire file stat" << std::endl;
+      abort();
+    }
+    size_t pos = pread_csr_block(fd, 0, offsets, edges);
+    pos = pread_csr_block(fd, pos, in_offsets, in_edges);
+    if (pos != static_cast<size_t>(sb.st_size)) {
+      std::cerr << "Error: Bad input graph" << std::endl;
+      abort();
+    }
+    close(fd);
+  }
+
   void read_graph(const char *filename) {
     std::string str_filename(filename);
     if (str_filename.find("hyperlink2012.bin") != std::string::npos) {
       // hack for hyperlink2012
-      read_hyperlink2012(filename);
+      read_hyperlink2012_pread(filename);
       return;
     }
     size_t idx = str_filename.find_last_of('.');
@@ -229,9 +506,9 @@ class Graph {
     }
     std::string subfix = str_filename.substr(idx + 1);
     if (subfix == "adj") {
-      read_pbbs_format(filename);
+      read_pbbs_format_chunked(filename);
     } else if (subfix == "bin") {
-      read_binary_format(filename);
+      read_binary_format_pread(filename);
     } else {
       std::cerr << "Error: Invalid graph extension" << std::endl;
       abort();
@@ -512,4 +789,162 @@ Graph Transpose(const Graph &G) {
   return edgelist2graph<NodeId, EdgeId, EdgeTy>(edgelist, n, m);
 }
 
+// Read-only view of a CSR graph in the binary layout
+// ([n][m][sizes][offsets][edges]) mapped straight from a file or a POSIX
+// shared-memory segment, so attaching is O(1) and every process attached to
+// the same segment shares one resident copy. Exposes the members the MIS
+// engines use (n, m, symmetrized, offsets[u], edges[e].v, degree,
+// map_neighbors). The mapped graph is assumed to be symmetrized; publish
+// one with publish_graph_shm (see tools/shm_graph).
+template <class _NodeId = uint32_t, class _EdgeId = uint64_t>
+class GraphView {
+ public:
+  using NodeId = _NodeId;
+  using EdgeId = _EdgeId;
+  using EdgeTy = Empty;
+  using Edge = WEdge<NodeId, Empty>;
+  static_assert(sizeof(NodeId) == sizeof(uint32_t) &&
+                    sizeof(EdgeId) == sizeof(uint64_t) &&
+                    sizeof(Edge) == sizeof(uint32_t),
+                "GraphView maps the 32-bit vertex / 64-bit offset layout");
+
+  size_t n = 0;
+  size_t m = 0;
+  bool symmetrized = true;
+  const EdgeId *offsets = nullptr;
+  const Edge *edges = nullptr;
+
+  GraphView() {}
+  GraphView(const GraphView &) = delete;
+  GraphView &operator=(const GraphView &) = delete;
+  ~GraphView() { detach(); }
+
+  // name is a POSIX shm name ("/friendster" or "friendster").
+  void attach_shm(const std::string &name) {
+    std::string shm_name = name[0] == '/' ? name : "/" + name;
+    int fd = shm_open(shm_name.c_str(), O_RDONLY, 0);
+    if (fd == -1) {
+      std::cerr << "Error: Cannot open shared memory " << shm_name << ": "
+                << std::strerror(errno) << std::endl;
+      abort();
+    }
+    attach_fd(fd, shm_name);
+  }
+
+  // Any file in the binary layout, e.g. a .bin file or a file on hugetlbfs.
+  void attach_file(const std::string &filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+      std::cerr << "Error: Cannot open file " << filename << std::endl;
+      abort();
+    }
+    attach_fd(fd, filename);
+  }
+
+  // Same naming rule as publish_graph_shm: a path is a file, else shm.
+  void attach(const std::string &name) {
+    if (name.find('/', 1) != std::string::npos) {
+      attach_file(name);
+    } else {
+      attach_shm(name);
+    }
+  }
+
+  void detach() {
+    if (base) munmap(base, length);
+    base = nullptr;
+    length = 0;
+    n = m = 0;
+    offsets = nullptr;
+    edges = nullptr;
+  }
+
+  size_t degree(NodeId u) const { return offsets[u + 1] - offsets[u]; }
+
+  template <class F>
+  void map_neighbors(NodeId u, F &&f) const {
+    for (EdgeId e = offsets[u]; e < offsets[u + 1]; e++) {
+      f(edges[e].v);
+    }
+  }
+
+ private:
+  void attach_fd(int fd, const std::string &what) {
+    detach();
+    struct stat sb;
+    if (fstat(fd, &sb) == -1) {
+      std::cerr << "Error: Unable to acquire file stat" << std::endl;
+      abort();
+    }
+    length = sb.st_size;
+    void *p = mmap(0, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED || length < 3 * 8) {
+      std::cerr << "Error: Cannot map graph " << what << std::endl;
+      abort();
+    }
+    base = p;
+    const uint64_t *header = static_cast<const uint64_t *>(base);
+    n = header[0];
+    m = header[1];
+    if (header[2] != (n + 1) * 8 + m * 4 + 3 * 8 || header[2] > length) {
+      std::cerr << "Error: Bad input graph " << what << std::endl;
+      abort();
+    }
+    offsets = reinterpret_cast<const EdgeId *>(header + 3);
+    edges = reinterpret_cast<const Edge *>(offsets + n + 1);
+  }
+
+  void *base = nullptr;
+  size_t length = 0;
+};
+
+// Copies G into a new POSIX shared-memory segment (or, if name contains a
+// '/' after the first character, a file such as one on hugetlbfs) in the
+// binary layout, for GraphView to attach. The segment outlives this
+// process until unlink_graph_shm. The size is rounded up to 2 MB so the
+// same code works on hugetlbfs.
+template <class Graph>
+void publish_graph_shm(const Graph &G, const std::string &name) {
+  static_assert(sizeof(typename Graph::EdgeId) == sizeof(uint64_t),
+                "binary layout stores 64-bit offsets");
+  bool is_file = name.find('/', 1) != std::string::npos;
+  std::string shm_name = (is_file || name[0] == '/') ? name : "/" + name;
+  int fd = is_file ? open(shm_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644)
+                   : shm_open(shm_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+  if (fd == -1) {
+    std::cerr << "Error: Cannot create " << shm_name << ": "
+              << std::strerror(errno) << std::endl;
+    abort();
+  }
+  size_t n = G.n, m = G.m;
+  size_t sizes = (n + 1) * 8 + m * 4 + 3 * 8;
+  size_t length = (sizes + (size_t(2) << 20) - 1) & ~((size_t(2) << 20) - 1);
+  void *p = MAP_FAILED;
+  if (ftruncate(fd, length) == 0) {
+    p = mmap(0, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (p == MAP_FAILED) {
+    std::cerr << "Error: Cannot size " << shm_name << ": "
+              << std::strerror(errno) << std::endl;
+    abort();
+  }
+  uint64_t *header = static_cast<uint64_t *>(p);
+  header[0] = n;
+  header[1] = m;
+  header[2] = sizes;
+  uint64_t *offs = header + 3;
+  uint32_t *adj = reinterpret_cast<uint32_t *>(offs + n + 1);
+  parlay::parallel_for(0, n + 1, [&](size_t i) { offs[i] = G.offsets[i]; });
+  parlay::parallel_for(0, m, [&](size_t i) { adj[i] = G.edges[i].v; });
+  munmap(p, length);
+}
+
+inline bool unlink_graph_shm(const std::string &name) {
+  if (name.find('/', 1) != std::string::npos) return unlink(name.c_str()) == 0;
+  std::string shm_name = name[0] == '/' ? name : "/" + name;
+  return shm_unlink(shm_name.c_str()) == 0;
+}
+
 #endif  // GRAPH_H
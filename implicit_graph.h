@@ -0,0 +1,168 @@
+#ifndef IMPLICIT_GRAPH_H
+#define IMPLICIT_GRAPH_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Graphs whose adjacency is computed arithmetically instead of stored.
+// They expose the subset of the Graph interface the MIS engines use:
+// NodeId/EdgeId, n, m, symmetrized, degree(u) and map_neighbors(u, f), so
+// e.g. MIS(G) in par_mis and SeqMIS(G) in seq_mis run on them with only the
+// per-vertex state of the algorithm itself. All of them are undirected.
+
+// rows x cols 4-neighbor grid, vertex u = r * cols + c. With torus = true
+// rows and columns wrap around (requires rows, cols >= 3 so that the four
+// neighbors are distinct).
+template <class _NodeId = uint32_t, class _EdgeId = uint64_t>
+class GridGraph {
+ public:
+  using NodeId = _NodeId;
+  using EdgeId = _EdgeId;
+
+  size_t n;
+  size_t m;
+  bool symmetrized = true;
+  size_t rows;
+  size_t cols;
+  bool torus;
+
+  GridGraph(size_t _rows, size_t _cols, bool _torus = false)
+      : rows(_rows), cols(_cols), torus(_torus) {
+    if (torus && (rows < 3 || cols < 3)) {
+      std::cerr << "Error: torus needs at least 3 rows and columns"
+                << std::endl;
+      abort();
+    }
+    if (__builtin_mul_overflow(rows, cols, &n) ||
+        n > std::numeric_limits<NodeId>::max()) {
+      std::cerr << "Error: " << rows << "x" << cols
+                << " grid does not fit in the vertex id type" << std::endl;
+      abort();
+    }
+    m = torus ? 4 * n : 2 * (rows * (cols - 1) + cols * (rows - 1));
+  }
+
+  size_t degree(NodeId u) const {
+    if (torus) return 4;
+    size_t r = u / cols, c = u % cols;
+    return (r > 0) + (r + 1 < rows) + (c > 0) + (c + 1 < cols);
+  }
+
+  // Neighbors in increasing id order for the plain grid.
+  template <class F>
+  void map_neighbors(NodeId u, F &&f) const {
+    size_t r = u / cols, c = u % cols;
+    if (torus) {
+      f(static_cast<NodeId>((r == 0 ? rows - 1 : r - 1) * cols + c));
+      f(static_cast<NodeId>(r * cols + (c == 0 ? cols - 1 : c - 1)));
+      f(static_cast<NodeId>(r * cols + (c + 1 == cols ? 0 : c + 1)));
+      f(static_cast<NodeId>((r + 1 == rows ? 0 : r + 1) * cols + c));
+      return;
+    }
+    if (r > 0) f(static_cast<NodeId>(u - cols));
+    if (c > 0) f(static_cast<NodeId>(u - 1));
+    if (c + 1 < cols) f(static_cast<NodeId>(u + 1));
+    if (r + 1 < rows) f(static_cast<NodeId>(u + cols));
+  }
+};
+
+// Circulant graph C_n(s_1, ..., s_k): u is adjacent to u +- s_i (mod n).
+// Jumps must be distinct and in [1, n / 2]; a jump of exactly n / 2 (even n)
+// contributes a single neighbor.
+template <class _NodeId = uint32_t, class _EdgeId = uint64_t>
+class CirculantGraph {
+ public:
+  using NodeId = _NodeId;
+  using EdgeId = _EdgeId;
+
+  size_t n;
+  size_t m;
+  bool symmetrized = true;
+  std::vector<size_t> jumps;
+
+  CirculantGraph(size_t _n, std::vector<size_t> _jumps)
+      : n(_n), jumps(std::move(_jumps)) {
+    if (n > std::numeric_limits<NodeId>::max()) {
+      std::cerr << "Error: circulant graph with n = " << n
+                << " does not fit in the vertex id type" << std::endl;
+      abort();
+    }
+    deg = 0;
+    for (size_t i = 0; i < jumps.size(); i++) {
+      size_t s = jumps[i];
+      if (s == 0 || 2 * s > n) {
+        std::cerr << "Error: circulant jump " << s << " out of range [1, "
+                  << n / 2 << "]" << std::endl;
+        abort();
+      }
+      for (size_t j = 0; j < i; j++) {
+        if (jumps[j] == s) {
+          std::cerr << "Error: duplicate circulant jump " << s << std::endl;
+          abort();
+        }
+      }
+      deg += (2 * s == n) ? 1 : 2;
+    }
+    m = n * deg;
+  }
+
+  size_t degree(NodeId) const { return deg; }
+
+  template <class F>
+  void map_neighbors(NodeId u, F &&f) const {
+    for (size_t s : jumps) {
+      f(static_cast<NodeId>(u + s < n ? u + s : u + s - n));
+      if (2 * s != n) f(static_cast<NodeId>(u >= s ? u - s : u + n - s));
+    }
+  }
+
+ private:
+  size_t deg;
+};
+
+// Parses an implicit graph spec and calls f(G) with the constructed graph:
+//   grid:<rows>x<cols>   torus:<rows>x<cols>   circulant:<n>:<s1>,<s2>,...
+// Returns false if spec is not an implicit graph spec (e.g. a file name).
+template <class F>
+bool with_implicit_graph(const std::string &spec, F &&f) {
+  size_t colon = spec.find(':');
+  if (colon == std::string::npos) return false;
+  std::string kind = spec.substr(0, colon);
+  std::string args = spec.substr(colon + 1);
+  if (kind == "grid" || kind == "torus") {
+    size_t x = args.find('x');
+    if (x == std::string::npos) return false;
+    size_t rows = std::strtoull(args.substr(0, x).c_str(), nullptr, 10);
+    size_t cols = std::strtoull(args.substr(x + 1).c_str(), nullptr, 10);
+    size_t n;
+    if (rows == 0 || cols == 0 || __builtin_mul_overflow(rows, cols, &n)) {
+      return false;
+    }
+    f(GridGraph<>(rows, cols, kind == "torus"));
+    return true;
+  }
+  if (kind == "circulant") {
+    size_t sep = args.find(':');
+    if (sep == std::string::npos) return false;
+    size_t n = std::strtoull(args.substr(0, sep).c_str(), nullptr, 10);
+    std::vector<size_t> jumps;
+    size_t pos = sep + 1;
+    while (pos <= args.size()) {
+      size_t comma = args.find(',', pos);
+      if (comma == std::string::npos) comma = args.size();
+      jumps.push_back(std::strtoull(args.substr(pos, comma - pos).c_str(),
+                                    nullptr, 10));
+      pos = comma + 1;
+    }
+    if (n == 0) return false;
+    f(CirculantGraph<>(n, jumps));
+    return true;
+  }
+  return false;
+}
+
+#endif  // IMPLICIT_GRAPH_H
@@ -0,0 +1,91 @@
+#include "graph.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+#include "matching.h"
+using namespace parlay;
+
+using MatchGraph = Graph<uint32_t, uint64_t>;
+using Workspace = MatchingWorkspace<uint32_t, uint64_t>;
+using Matching = parlay::sequence<std::pair<uint32_t, uint32_t>>;
+
+// 对照：按同样的边优先级串行贪心，两端都没配对就选
+Matching greedy_matching(const Workspace& ws) {
+    size_t k = ws.num_edges();
+    auto order = parlay::sequence<uint64_t>::uninitialized(k);
+    parlay::parallel_for(0, k, [&](size_t e) { order[ws.rank[e]] = e; });
+    std::vector<bool> matched(ws.n, false);
+    Matching out;
+    for (uint64_t e : order) {
+        auto [u, v] = ws.ends[e];
+        if (matched[u] || matched[v]) continue;
+        matched[u] = matched[v] = true;
+        out.push_back(ws.ends[e]);
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) { std::cerr << "Usage: ./matching input_graph [verify]" << std::endl; return 1; }
+    const char* filename = argv[1];
+    std::string graphname = std::filesystem::path(filename).stem().string();
+    MatchGraph G;
+    G.read_graph(filename);
+    if (!G.symmetrized) { G = make_symmetrized(G); }
+
+    // 第一次调用包括建关联表，之后同一个 seed 复用；warm 是再跑 3 次的平均
+    Workspace ws;
+    internal::timer t;
+    auto matching = MaximalMatching(G, ws);
+    double cold = t.next_time();
+    double total = 0;
+    for (int run = 0; run < 3; run++) {
+        t.next_time();
+        matching = MaximalMatching(G, ws);
+        total += t.next_time();
+    }
+    std::cout << graphname << "    cold " << cold << "s  warm " << total / 3 << "s  |M|=" << matching.size()
+              << "  rounds " << ws.rounds << "  (" << ws.num_edges() << " undirected edges)" << std::endl;
+
+    // 合法：每个顶点最多在一条匹配边里，匹配边都是图里的边
+    auto hits = parlay::sequence<std::atomic<uint32_t>>(G.n);
+    parlay::parallel_for(0, G.n, [&](size_t u) { hits[u].store(0); });
+    parlay::parallel_for(0, matching.size(), [&](size_t i) {
+        hits[matching[i].first].fetch_add(1);
+        hits[matching[i].second].fetch_add(1);
+    });
+    size_t shared = parlay::count_if(parlay::iota<size_t>(G.n), [&](size_t u) { return hits[u].load() > 1; });
+    if (shared != 0) std::cout << "❌ matching invalid: " << shared << " vertices in more than one edge" << std::endl;
+    size_t missing = parlay::count_if(matching, [&](const std::pair<uint32_t, uint32_t>& e) {
+        bool found = false;
+        G.map_neighbors(e.first, [&](uint32_t v) { found |= v == e.second; });
+        return !found;
+    });
+    if (missing != 0) std::cout << "❌ matching invalid: " << missing << " edges not in the graph" << std::endl;
+    // 极大：没有两端都没配对的边
+    size_t free_edges = parlay::reduce(parlay::delayed_seq<size_t>(G.n, [&](size_t u) {
+        if (hits[u].load()) return (size_t)0;
+        size_t local = 0;
+        G.map_neighbors(u, [&](uint32_t v) { local += u < v && !hits[v].load(); });
+        return local;
+    }));
+    if (free_edges != 0) std::cout << "⚠️ matching not maximal: " << free_edges << " edges could be added\n";
+
+    bool verify = argc == 3 && std::atoi(argv[2]) != 0;
+    if (verify) {
+        if (greedy_matching(ws) != matching) std::cout << "⚠️ differs from sequential greedy in priority order\n";
+        std::filesystem::create_directories("./results");
+        std::ofstream out("./results/" + graphname + "_matching.txt");
+        out << "# matching size: " << matching.size() << "\n";
+        for (auto [u, v] : matching) out << u << " " << v << "\n";
+    }
+    return shared == 0 && missing == 0 && free_edges == 0 ? 0 : 1;
+}
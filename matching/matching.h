@@ -0,0 +1,186 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+#include "parlay/random.h"
+#include "counter.h"
+#include "perf_counters.h"
+#include "priority.h"
+
+// 极大匹配：把 par_mis 的“随机优先级 + 计数器 + frontier”套到边上，等价于在线图上跑 par_mis，
+// 但线图不建出来。结果是按边优先级串行贪心得到的那个匹配（字典序最小的极大匹配）。
+//
+// 预处理（同一张图、同一个 seed 只做一次，图按 GraphKey 认）：无向边去重编号 e = (lo, hi)，lo < hi，
+// 优先级是边编号的随机排列；每个顶点的关联边按优先级排好序（incidence）。
+//
+// 线图上的计数器（比 e 优先的相邻边数）初始化和递减都是 Σ deg² 的量，高度数顶点受不了。
+// 这里换成每个顶点一个 head 指针：head[x] 是 x 的表里第一条没删的边，
+// counter[e] = e 还不是 head 的端点数（0..2），为 0 就是两端更优先的边都删完了，进 frontier。
+//
+// 每轮：frontier 里的边两两不共享端点（各自是两端的 head），全部入选，两个端点记上 mate；
+// 端点 x 的表里排在 e 后面的边 f 用 CAS 抢成 REMOVED，抢到的 f 的另一端 y 记为 touched；
+// 然后每个 touched 的 y（一个任务一个）把 head 往后推过已删的边，推到新的边 g 就给 counter[g] 减一，
+// 从 1 变 0 的进下一轮 frontier。每条边最多被删一次、每个 head 只往后走，总工作量 O(m)。
+enum EdgeStatus : uint8_t { EDGE_UNDECIDED, EDGE_SELECTED, EDGE_REMOVED };
+
+template <class NodeId, class EdgeId>
+struct MatchingWorkspace {
+    static constexpr NodeId kUnmatched = std::numeric_limits<NodeId>::max();
+
+    size_t n = 0;
+    parlay::sequence<std::pair<NodeId, NodeId>> ends;  // 无向边，first < second
+    parlay::sequence<EdgeId> rank;                     // 边的优先级，越小越优先
+    parlay::sequence<EdgeId> inc_offsets;              // 顶点 x 的关联边：inc[inc_offsets[x], inc_offsets[x + 1])
+    parlay::sequence<EdgeId> inc;                      // 按优先级排好的关联边编号
+    parlay::sequence<std::atomic<uint8_t>> status;
+    parlay::sequence<Counter> counter;
+    parlay::sequence<EdgeId> frontier, next_frontier;
+    parlay::sequence<EdgeId> head;                     // x 的表里第一条没删的边的位置（绝对下标）
+    parlay::sequence<std::atomic<uint8_t>> touched;
+    parlay::sequence<NodeId> touched_list;
+    parlay::sequence<NodeId> mate;
+    size_t rounds = 0;  // 上一次调用的轮数
+
+    size_t priority_seed = 0;
+    GraphKey graph;  // 建表时的图（见 priority.h），地址一样但内容换了也要重建
+    bool built = false;
+
+    size_t num_edges() const { return ends.size(); }
+
+    template <class Graph>
+    void build(const Graph& G, size_t seed) {
+        GraphKey key = GraphKey::of(G);
+        if (built && graph == key && priority_seed == seed) return;
+        n = G.n;
+        graph = key;
+        priority_seed = seed;
+        built = true;
+        auto lists = parlay::tabulate(n, [&](size_t u) {
+            std::vector<std::pair<NodeId, NodeId>> out;
+            G.map_neighbors(static_cast<NodeId>(u), [&](NodeId v) {
+                if (u < v) out.emplace_back(static_cast<NodeId>(u), v);
+            });
+            std::sort(out.begin(), out.end());
+            out.erase(std::unique(out.begin(), out.end()), out.end());
+            return out;
+        });
+        ends = parlay::flatten(lists);
+        size_t k = ends.size();
+        rank = parlay::random_permutation<EdgeId>(k, seed);
+        auto pairs = parlay::sequence<std::pair<NodeId, EdgeId>>::uninitialized(2 * k);
+        parlay::parallel_for(0, k, [&](size_t e) {
+            pairs[2 * e] = {ends[e].first, static_cast<EdgeId>(e)};
+            pairs[2 * e + 1] = {ends[e].second, static_cast<EdgeId>(e)};
+        });
+        parlay::sort_inplace(pairs, [&](const std::pair<NodeId, EdgeId>& a, const std::pair<NodeId, EdgeId>& b) {
+            return a.first != b.first ? a.first < b.first : rank[a.second] < rank[b.second];
+        });
+        inc = parlay::tabulate(2 * k, [&](size_t i) { return pairs[i].second; });
+        inc_offsets = parlay::sequence<EdgeId>(n + 1, 2 * k);
+        parlay::parallel_for(0, 2 * k, [&](size_t i) {
+            if (i == 0 || pairs[i].first != pairs[i - 1].first) inc_offsets[pairs[i].first] = i;
+        });
+        parlay::scan_inclusive_inplace(parlay::make_slice(inc_offsets.rbegin(), inc_offsets.rend()),
+                                       parlay::minm<EdgeId>());
+        status = parlay::sequence<std::atomic<uint8_t>>(k);
+        counter = parlay::sequence<Counter>(k);
+        frontier = parlay::sequence<EdgeId>::uninitialized(k);
+        next_frontier = parlay::sequence<EdgeId>::uninitialized(k);
+        head = parlay::sequence<EdgeId>::uninitialized(n);
+        touched = parlay::sequence<std::atomic<uint8_t>>(n);
+        touched_list = parlay::sequence<NodeId>::uninitialized(n);
+        mate = parlay::sequence<NodeId>::uninitialized(n);
+    }
+};
+
+// 返回匹配的边 (lo, hi)，按 lo 排序。seed 决定边的优先级；同一 seed 下结果确定
+template <class Graph>
+parlay::sequence<std::pair<typename Graph::NodeId, typename Graph::NodeId>> MaximalMatching(
+    const Graph& G, MatchingWorkspace<typename Graph::NodeId, typename Graph::EdgeId>& ws, size_t seed = 0,
+    PhaseProfile* prof = nullptr) {
+    using NodeId = typename Graph::NodeId;
+    using EdgeId = typename Graph::EdgeId;
+    if (prof) prof->start();
+    ws.build(G, seed);
+    if (prof) prof->lap("incidence");
+    size_t k = ws.num_edges();
+    auto& status = ws.status;
+    auto& counter = ws.counter;
+    auto& inc = ws.inc;
+    auto& inc_offsets = ws.inc_offsets;
+    auto& ends = ws.ends;
+    auto& mate = ws.mate;
+    auto& head = ws.head;
+    auto& touched = ws.touched;
+    parlay::parallel_for(0, G.n, [&](size_t u) {
+        mate[u] = ws.kUnmatched;
+        head[u] = inc_offsets[u];
+        touched[u].store(0, std::memory_order_relaxed);
+    });
+    auto is_head = [&](EdgeId e, NodeId x) { return inc[inc_offsets[x]] == e; };
+    parlay::parallel_for(0, k, [&](size_t e) {
+        status[e].store(EDGE_UNDECIDED, std::memory_order_relaxed);
+        counter[e].reset(!is_head(e, ends[e].first) + !is_head(e, ends[e].second));
+    });
+    size_t frontier_size = parlay::filter_into_uninitialized(
+        parlay::iota<EdgeId>(k), ws.frontier, [&](EdgeId e) { return counter[e].is_zero(); });
+    if (prof) prof->lap("counter_init");
+
+    ws.rounds = 0;
+    while (frontier_size != 0) {
+        auto& frontier = ws.frontier;
+        auto& next_frontier = ws.next_frontier;
+        // step 1: frontier 的边入选，端点配对（frontier 的边两两不共享端点）
+        parlay::parallel_for(0, frontier_size, [&](size_t i) {
+            EdgeId e = frontier[i];
+            status[e].store(EDGE_SELECTED, std::memory_order_relaxed);
+            mate[ends[e].first] = ends[e].second;
+            mate[ends[e].second] = ends[e].first;
+        });
+        // step 2: 删掉和入选边共享端点的边（e 是 x 的 head，所以从 head[x] + 1 开始），记下它们的另一端
+        std::atomic<size_t> touched_size = 0;
+        parlay::parallel_for(0, 2 * frontier_size, [&](size_t i) {
+            EdgeId e = frontier[i / 2];
+            NodeId x = i % 2 ? ends[e].second : ends[e].first;
+            for (EdgeId a = head[x] + 1; a < inc_offsets[x + 1]; a++) {
+                EdgeId f = inc[a];
+                uint8_t expected = EDGE_UNDECIDED;
+                if (!status[f].compare_exchange_strong(expected, EDGE_REMOVED)) continue;
+                NodeId y = ends[f].first == x ? ends[f].second : ends[f].first;
+                if (touched[y].exchange(1, std::memory_order_relaxed) == 0) {
+                    ws.touched_list[touched_size.fetch_add(1)] = y;
+                }
+            }
+        });
+        // step 3: touched 的顶点推进 head，新的 head 边计数减一
+        std::atomic<size_t> write_ptr = 0;
+        parlay::parallel_for(0, touched_size.load(), [&](size_t i) {
+            NodeId y = ws.touched_list[i];
+            touched[y].store(0, std::memory_order_relaxed);
+            if (mate[y] != ws.kUnmatched) return;  // y 这轮配上了，它的边都决定了
+            EdgeId h = head[y], end = inc_offsets[y + 1];
+            while (h < end && status[inc[h]].load(std::memory_order_relaxed) == EDGE_REMOVED) h++;
+            if (h == head[y]) return;
+            head[y] = h;
+            if (h < end && counter[inc[h]].decrement_to_zero()) {
+                next_frontier[write_ptr.fetch_add(1)] = inc[h];
+            }
+        });
+        ws.rounds++;
+        if (prof) prof->lap_round(frontier_size);
+        std::swap(ws.frontier, ws.next_frontier);
+        frontier_size = write_ptr.load();
+    }
+
+    auto matching = parlay::map(
+        parlay::filter(parlay::iota<EdgeId>(k), [&](EdgeId e) { return status[e].load() == EDGE_SELECTED; }),
+        [&](EdgeId e) { return ends[e]; });
+    if (prof) prof->lap("extract");
+    return matching;
+}
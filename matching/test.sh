@@ -0,0 +1,5 @@
+make clean
+make
+for g in $(grep -v '^#' ../testcases/graphnames.txt); do ./matching ../testcases/bin/$g.bin; done
+#./matching ../testcases/bin/friendster_sym.bin 1
+#./matching ../testcases/bin/com-orkut_sym.bin
@@ -0,0 +1,349 @@
+#pragma once
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "graph.h"
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+#include "parlay/random.h"
+#include "counter.h"
+#include "perf_counters.h"
+#include "simd_count.h"
+
+// 外存分片版的 par_mis：图切成按顶点区间划分的分片放在磁盘上，内存里只留 O(n) 的
+// status / priority / counter 和分片边界。每轮分两步：
+//   A 读含有 frontier 顶点的分片，删掉 frontier 的邻居 v
+//   B 读含有本轮被删顶点 v 的分片，给 v 的低优先级邻居 w 的计数器减一，归零的进下一轮 frontier
+// 没有活跃顶点的分片直接跳过（每一步按分片算一个活跃位图）。和 par_mis 同样的排列、同样的计数规则，
+// 所以结果一样是字典序最小的 MIS。
+//
+// 目录格式：meta.bin = [n][m][分片数 S][边界 S+1 个][每片边数 S 个]（都是 u64）
+//           shard_<i>.bin = [lo][hi][m_i] + 片内 offsets (hi-lo+1 个 u64，从 0 开始) + edges (m_i 个 u32)
+struct ShardSet {
+    std::string dir;
+    size_t n = 0, m = 0;
+    std::vector<uint64_t> bounds;       // 分片 i 是顶点 [bounds[i], bounds[i+1])
+    std::vector<uint64_t> shard_edges;  // 分片 i 的边数
+
+    size_t num_shards() const { return shard_edges.size(); }
+    size_t vertices(size_t i) const { return bounds[i + 1] - bounds[i]; }
+    size_t shard_bytes(size_t i) const { return 3 * sizeof(uint64_t) + (vertices(i) + 1) * sizeof(uint64_t) + shard_edges[i] * sizeof(uint32_t); }
+    std::string shard_path(size_t i) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "shard_%05zu.bin", i);
+        return dir + "/" + name;
+    }
+
+    bool load_meta(const std::string& _dir) {
+        dir = _dir;
+        FILE* f = std::fopen((dir + "/meta.bin").c_str(), "rb");
+        if (!f) return false;
+        uint64_t header[3];
+        bool ok = std::fread(header, sizeof(uint64_t), 3, f) == 3;
+        if (ok) {
+            n = header[0], m = header[1];
+            bounds.resize(header[2] + 1);
+            shard_edges.resize(header[2]);
+            ok = std::fread(bounds.data(), sizeof(uint64_t), bounds.size(), f) == bounds.size() &&
+                 std::fread(shard_edges.data(), sizeof(uint64_t), shard_edges.size(), f) == shard_edges.size();
+        }
+        std::fclose(f);
+        return ok;
+    }
+};
+
+// 已有的分片是不是这张输入图切出来的：n、m 和 .bin 头一致，而且输入文件不比 meta.bin 新
+// （同名的图重新生成过就要重切）
+inline bool shards_match(const ShardSet& S, const char* filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        std::cerr << "Error: Cannot open file " << filename << std::endl;
+        abort();
+    }
+    uint64_t header[2];
+    bool ok = pread(fd, header, sizeof(header), 0) == sizeof(header);
+    close(fd);
+    if (!ok || header[0] != S.n || header[1] != S.m) return false;
+    std::error_code ec;
+    auto input_time = std::filesystem::last_write_time(filename, ec);
+    if (ec) return false;
+    auto meta_time = std::filesystem::last_write_time(S.dir + "/meta.bin", ec);
+    return !ec && input_time <= meta_time;
+}
+
+// 内存里的一个分片；缓冲区在多次加载之间复用
+struct LoadedShard {
+    size_t id = SIZE_MAX;
+    uint64_t lo = 0, hi = 0;
+    parlay::sequence<uint64_t> offsets;
+    parlay::sequence<uint32_t> edges;
+
+    template <class F>
+    void map_neighbors(uint64_t u, F&& f) const {
+        for (uint64_t e = offsets[u - lo]; e < offsets[u - lo + 1]; e++) f(edges[e]);
+    }
+};
+
+// 读入分片 i，返回读的字节数
+inline size_t load_shard(const ShardSet& S, size_t i, LoadedShard& out, size_t chunk = size_t(64) << 20) {
+    int fd = open(S.shard_path(i).c_str(), O_RDONLY);
+    if (fd == -1) {
+        std::cerr << "Error: Cannot open file " << S.shard_path(i) << std::endl;
+        abort();
+    }
+    uint64_t header[3];
+    pread_parallel(fd, header, sizeof(header), 0, chunk);
+    if (header[0] != S.bounds[i] || header[1] != S.bounds[i + 1] || header[2] != S.shard_edges[i]) {
+        std::cerr << "Error: Shard " << S.shard_path(i) << " does not match meta.bin" << std::endl;
+        abort();
+    }
+    out.id = i;
+    out.lo = header[0];
+    out.hi = header[1];
+    size_t nv = out.hi - out.lo;
+    out.offsets.resize(nv + 1);
+    out.edges.resize(header[2]);
+    size_t pos = sizeof(header);
+    pread_parallel(fd, out.offsets.begin(), (nv + 1) * sizeof(uint64_t), pos, chunk);
+    pos += (nv + 1) * sizeof(uint64_t);
+    pread_parallel(fd, out.edges.begin(), header[2] * sizeof(uint32_t), pos, chunk);
+    close(fd);
+    return S.shard_bytes(i);
+}
+
+// 把 .bin 图切成每片大约 shard_bytes 字节（按 8 字节/顶点 + 4 字节/边估算）的分片，写进 dir。
+// 一次只在内存里放一片的边；offsets 整个读进来（8n 字节）用来定边界。
+inline ShardSet build_shards(const char* filename, const std::string& dir, size_t shard_bytes,
+                             size_t chunk = size_t(64) << 20) {
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        std::cerr << "Error: Cannot open file " << filename << std::endl;
+        abort();
+    }
+    uint64_t header[3];
+    pread_parallel(fd, header, sizeof(header), 0, chunk);
+    ShardSet S;
+    S.dir = dir;
+    S.n = header[0];
+    S.m = header[1];
+    parlay::sequence<uint64_t> offsets(S.n + 1);
+    pread_parallel(fd, offsets.begin(), (S.n + 1) * sizeof(uint64_t), sizeof(header), chunk);
+    size_t edges_begin = sizeof(header) + (S.n + 1) * sizeof(uint64_t);
+    if (header[2] != edges_begin + S.m * sizeof(uint32_t) || offsets[S.n] != S.m) {
+        std::cerr << "Error: Bad input graph" << std::endl;
+        abort();
+    }
+
+    S.bounds.push_back(0);
+    size_t acc = 0;
+    for (size_t u = 0; u < S.n; u++) {
+        acc += sizeof(uint64_t) + (offsets[u + 1] - offsets[u]) * sizeof(uint32_t);
+        if (acc >= shard_bytes || u + 1 == S.n) {
+            S.bounds.push_back(u + 1);
+            acc = 0;
+        }
+    }
+    if (S.n == 0) S.bounds.push_back(0);
+    size_t shards = S.bounds.size() - 1;
+    S.shard_edges.resize(shards);
+    std::filesystem::create_directories(dir);
+
+    parlay::sequence<uint64_t> local;
+    parlay::sequence<uint32_t> edges;
+    for (size_t i = 0; i < shards; i++) {
+        uint64_t lo = S.bounds[i], hi = S.bounds[i + 1];
+        uint64_t e_lo = offsets[lo], e_hi = offsets[hi];
+        S.shard_edges[i] = e_hi - e_lo;
+        local = parlay::tabulate(hi - lo + 1, [&](size_t j) { return offsets[lo + j] - e_lo; });
+        edges.resize(e_hi - e_lo);
+        pread_parallel(fd, edges.begin(), (e_hi - e_lo) * sizeof(uint32_t), edges_begin + e_lo * sizeof(uint32_t), chunk);
+        FILE* f = std::fopen(S.shard_path(i).c_str(), "wb");
+        uint64_t sh[3] = {lo, hi, e_hi - e_lo};
+        bool ok = f && std::fwrite(sh, sizeof(uint64_t), 3, f) == 3 &&
+                  std::fwrite(local.begin(), sizeof(uint64_t), local.size(), f) == local.size() &&
+                  std::fwrite(edges.begin(), sizeof(uint32_t), edges.size(), f) == edges.size();
+        if (f) ok &= std::fclose(f) == 0;
+        if (!ok) {
+            std::cerr << "Error: Cannot write " << S.shard_path(i) << std::endl;
+            abort();
+        }
+    }
+    close(fd);
+
+    FILE* f = std::fopen((dir + "/meta.bin").c_str(), "wb");
+    uint64_t mh[3] = {S.n, S.m, shards};
+    bool ok = f && std::fwrite(mh, sizeof(uint64_t), 3, f) == 3 &&
+              std::fwrite(S.bounds.data(), sizeof(uint64_t), S.bounds.size(), f) == S.bounds.size() &&
+              std::fwrite(S.shard_edges.data(), sizeof(uint64_t), shards, f) == shards;
+    if (f) ok &= std::fclose(f) == 0;
+    if (!ok) {
+        std::cerr << "Error: Cannot write " << dir << "/meta.bin" << std::endl;
+        abort();
+    }
+    return S;
+}
+
+struct OOCRound {
+    size_t frontier = 0;       // 本轮入选
+    size_t removed = 0;        // 本轮被删
+    size_t shards_read = 0;    // A、B 两步一共读的分片数
+    size_t shards_skipped = 0; // 两步里跳过的分片数
+    size_t bytes = 0;          // 本轮读盘字节数
+};
+
+struct OOCResult {
+    parlay::sequence<uint32_t> mis;
+    std::vector<OOCRound> rounds;
+    size_t init_bytes = 0;     // 计数器初始化那一遍读的字节数
+};
+
+// 最多同时放 capacity 个分片，满了换出最久没用的（LRU）。capacity 不小于分片数时初始化之后就不再读盘。
+class ShardCache {
+public:
+    ShardCache(size_t capacity, size_t num_shards)
+        : slots(std::clamp<size_t>(capacity, 1, std::max<size_t>(num_shards, 1))), slot_of(num_shards, SIZE_MAX) {
+        for (size_t k = 0; k < slots.size(); k++) where.push_back(lru.insert(lru.end(), k));
+    }
+
+    const LoadedShard* find(size_t id) {
+        size_t k = slot_of[id];
+        if (k == SIZE_MAX) return nullptr;
+        touch(k);
+        return &slots[k];
+    }
+
+    // 读入分片 id（换掉最久没用的槽），bytes 加上读的字节数
+    const LoadedShard& load(const ShardSet& S, size_t id, size_t& bytes) {
+        size_t k = lru.front();
+        if (slots[k].id != SIZE_MAX) slot_of[slots[k].id] = SIZE_MAX;
+        bytes += load_shard(S, id, slots[k]);
+        slot_of[id] = k;
+        touch(k);
+        return slots[k];
+    }
+
+    size_t capacity() const { return slots.size(); }
+
+private:
+    void touch(size_t k) {
+        lru.splice(lru.end(), lru, where[k]);
+    }
+
+    std::vector<LoadedShard> slots;
+    std::vector<size_t> slot_of;   // 分片 -> 槽，不在缓存里是 SIZE_MAX
+    std::list<size_t> lru;         // 槽，最久没用的在前
+    std::vector<std::list<size_t>::iterator> where;   // 槽在 lru 里的位置
+};
+
+struct ShardPass {
+    size_t active = 0;  // 活跃（有顶点落在里面）的分片数
+    size_t reads = 0;   // 实际读盘的分片数（已经在缓存里的不算）
+    size_t bytes = 0;
+};
+
+// 按分片处理一个排好序的顶点列表：先按分片边界切出每片的那一段、得到活跃位图，
+// 只处理活跃分片，对每个顶点调用 f(shard, u)。已经在缓存里的活跃分片先处理，再依次读其余的。
+template <class F>
+ShardPass for_active_shards(const ShardSet& S, ShardCache& cache, const parlay::sequence<uint32_t>& sorted, F&& f) {
+    size_t S_count = S.num_shards();
+    std::vector<std::pair<size_t, size_t>> slice(S_count);
+    std::vector<bool> active(S_count, false);
+    ShardPass pass;
+    for (size_t i = 0; i < S_count; i++) {
+        size_t lo = std::lower_bound(sorted.begin(), sorted.end(), S.bounds[i]) - sorted.begin();
+        size_t hi = std::lower_bound(sorted.begin() + lo, sorted.end(), S.bounds[i + 1]) - sorted.begin();
+        slice[i] = {lo, hi};
+        active[i] = lo < hi;
+        pass.active += active[i];
+    }
+    auto run = [&](const LoadedShard& shard, size_t i) {
+        parlay::parallel_for(slice[i].first, slice[i].second, [&](size_t j) { f(shard, sorted[j]); });
+        active[i] = false;
+    };
+    for (size_t i = 0; i < S_count; i++) {
+        if (!active[i]) continue;
+        if (const LoadedShard* shard = cache.find(i)) run(*shard, i);
+    }
+    for (size_t i = 0; i < S_count; i++) {
+        if (!active[i]) continue;
+        run(cache.load(S, i, pass.bytes), i);
+        pass.reads++;
+    }
+    return pass;
+}
+
+// cache_shards：内存里最多同时放几个分片
+inline OOCResult OutOfCoreMIS(const ShardSet& S, size_t cache_shards = 1, size_t seed = 0,
+                              PhaseProfile* prof = nullptr) {
+    using NodeId = uint32_t;
+    size_t n = S.n;
+    if (prof) prof->start();
+    enum Status : uint8_t { UNDECIDED = 0, SELECTED = 1, REMOVED = 2 };
+    OOCResult res;
+
+    auto priority = parlay::random_permutation<NodeId>(n, seed);
+    parlay::sequence<std::atomic<uint8_t>> status(n);
+    parlay::sequence<Counter> counter(n);
+    ShardCache cache(cache_shards, S.num_shards());
+    // 计数器初始化：所有分片读一遍（最后 cache_shards 个留在缓存里）
+    for (size_t i = 0; i < S.num_shards(); i++) {
+        const LoadedShard& shard = cache.load(S, i, res.init_bytes);
+        parlay::parallel_for(shard.lo, shard.hi, [&](size_t u) {
+            uint64_t lo = shard.offsets[u - shard.lo], hi = shard.offsets[u - shard.lo + 1];
+            counter[u].reset(count_gathered<false>(priority.begin(), shard.edges.begin() + lo, hi - lo,
+                                                   priority[u], simd_level()));
+            status[u].store(UNDECIDED, std::memory_order_relaxed);
+        });
+    }
+    auto frontier = parlay::filter(parlay::iota<NodeId>(n), [&](NodeId u) { return counter[u].is_zero(); });
+    parlay::sequence<NodeId> buffer(n);
+    if (prof) prof->lap("counter_init");
+
+    while (!frontier.empty()) {
+        OOCRound round;
+        round.frontier = frontier.size();
+        parlay::parallel_for(0, frontier.size(), [&](size_t i) {
+            status[frontier[i]].store(SELECTED, std::memory_order_relaxed);
+        });
+        // A：删掉 frontier 的邻居
+        std::atomic<size_t> write_ptr = 0;
+        ShardPass a = for_active_shards(S, cache, frontier, [&](const LoadedShard& sh, NodeId u) {
+            sh.map_neighbors(u, [&](NodeId v) {
+                uint8_t expected = UNDECIDED;
+                if (status[v].compare_exchange_strong(expected, REMOVED)) buffer[write_ptr.fetch_add(1)] = v;
+            });
+        });
+        auto removed = parlay::sort(buffer.cut(0, write_ptr.load()));
+        round.removed = removed.size();
+        // B：被删点的低优先级邻居计数器减一
+        write_ptr = 0;
+        ShardPass b = for_active_shards(S, cache, removed, [&](const LoadedShard& sh, NodeId v) {
+            sh.map_neighbors(v, [&](NodeId w) {
+                if (status[w].load() == UNDECIDED && priority[w] > priority[v]) {
+                    if (counter[w].decrement_to_zero()) buffer[write_ptr.fetch_add(1)] = w;
+                }
+            });
+        });
+        frontier = parlay::sort(buffer.cut(0, write_ptr.load()));
+        round.shards_read = a.reads + b.reads;
+        round.shards_skipped = 2 * S.num_shards() - a.active - b.active;
+        round.bytes = a.bytes + b.bytes;
+        res.rounds.push_back(round);
+        if (prof) prof->lap_round(round.frontier);
+    }
+
+    res.mis = parlay::filter(parlay::iota<NodeId>(n), [&](NodeId u) { return status[u] == SELECTED; });
+    if (prof) prof->lap("extract");
+    return res;
+}
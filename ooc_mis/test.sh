@@ -0,0 +1,4 @@
+make clean
+make
+./mis ../testcases/bin/friendster_sym.bin 1
+#./mis ../testcases/bin/hyperlink2012_sym.bin 0 1024 4 /mnt/nvme/hyperlink2012.shards
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "utils/utils.h"
 #include "graph.h"
+#include "implicit_graph.h"
 #include <vector>
 #include <iostream>
 #include <sstream> 
@@ -8,94 +9,17 @@
 #include "parlay/parallel.h"
 #include "parlay/primitives.h"
 #include "parlay/random.h"
-#include "counter.h"
-#include "tools.h"
+#include "mis.h"
 #include <atomic>
 #include <iostream>
 #include <chrono>
 #include <filesystem>
+#include <iomanip>
+#include <map>
+#include <numeric>
+#include "scaling.h"
 using namespace parlay;
 
-template <class Graph>
-parlay::sequence<typename Graph::NodeId> MIS(const Graph& G) {
-    using NodeId = typename Graph::NodeId;
-    size_t n = G.n;
-    enum Status : uint64_t { UNDECIDED = 0, SELECTED = 1, REMOVED = 2 };
-    sequence<std::atomic<uint64_t>> status(n);                    // status:  顶点当前的状态
-    auto priority = parlay::random_permutation<NodeId>(n);
-    // counter: verified_value = 0, approxmt_count = 0, targeted_value = 顶点的邻居比他优先级更高并且未被处理的数量
-    sequence<Counter> counter = parlay::tabulate(n, [&](size_t u) {
-        int count = 0;
-        for (size_t e = G.offsets[u]; e < G.offsets[u + 1]; e++) {
-            NodeId v = G.edges[e].v;
-            if (priority[v] < priority[u]) count++;
-        }
-        return Counter(count);
-    });
-    //show_counter(counter, n);
-    sequence<NodeId> frontier = filter(                          // frontier: 准备标记Selected的点，初始化为counter为0的
-        iota<NodeId>(n),
-        [&](NodeId u) { return counter[u].is_zero(); }
-    );
-
-    while (!frontier.empty()) {
-
-        // step 1: frontier里面的点全部标记 Selected
-        parallel_for(0, frontier.size(), [&](size_t i) {
-            status[frontier[i]].store(SELECTED, std::memory_order_relaxed);
-        });
-
-        // step 2: 初始化下一轮 frontier 的写入空间
-        parlay::sequence<NodeId> next_frontier = parlay::sequence<NodeId>::uninitialized(G.m);
-        std::atomic<size_t> write_ptr = 0;
-
-        const size_t WIDTH = 10000;
-        for (size_t start = 0; start < frontier.size(); start += WIDTH) {
-            size_t end = std::min(start + WIDTH, frontier.size());
-            // step 3: frontier的邻居全部设置为Removed, 邻居的邻居的计数器看情况调整
-            parallel_for(start, end, [&](size_t i) {
-                NodeId u = frontier[i];
-                for (size_t e = G.offsets[u]; e < G.offsets[u + 1]; e++) {
-                    // v: frontier的邻居
-                    NodeId v = G.edges[e].v;
-                    uint64_t expected = UNDECIDED;
-                    // 原子地访问邻居，避免两个线程重复工作
-                    if (status[v].compare_exchange_strong(expected, REMOVED)) {
-                        // 只有成功设置了Removed的邻居能进来
-                        // 邻居的邻居中，如果优先级低，则计数器--
-                        for (size_t f = G.offsets[v]; f < G.offsets[v + 1]; f++) {
-                            // w: frontier的邻居的邻居
-                            NodeId w = G.edges[f].v;
-                            if (status[w].load() == UNDECIDED && priority[w] > priority[v]) {
-                                counter[w]--;
-                                // 生成新的frontier
-                                if (counter[w].is_zero()) { 
-                                    size_t pos = write_ptr.fetch_add(1);
-                                    next_frontier[pos] = w;
-                                }
-                            }
-                        }
-                    }
-                }
-            });
-        }
-
-        // step 4: 去重 + 切割有效部分
-        size_t new_size = write_ptr.load();
-        next_frontier = parlay::to_sequence(next_frontier.cut(0, new_size));
-        next_frontier = parlay::unique(parlay::sort(next_frontier));
-
-        // step 5: 更新 frontier
-        frontier = std::move(next_frontier);
-    }
-
-    // 过滤出Selected，返回
-    auto mis = filter(iota<NodeId>(n), [&](NodeId u) {
-        return status[u] == SELECTED;
-    });
-    return mis;
-}
-
 template <class NodeId>
 void save_mis_to_file(const parlay::sequence<NodeId>& mis_set,
                       const std::string& filename) {
@@ -128,33 +52,388 @@ void save_mis_to_file(const parlay::sequence<NodeId>& mis_set,
     out.close();
 }
 
-int main(int argc, char* argv[]) {
-    if (argc < 2 || argc > 3) { std::cerr << "Usage: ./mis input_graph [verify]" << std::endl; return 1; }
-    const char* filename = argv[1];
-    Graph<uint32_t, uint64_t> G;
-    G.read_graph(filename);
-    if (!G.symmetrized) { G = make_symmetrized(G); }
-    // Warm up
-    { auto tmp = MIS(G); }
-    // Test
-    std::string graphname = std::filesystem::path(filename).stem().string();
+// 计时循环：warm up 一次，再跑 runs 次，共用工作区 ws；各阶段时间取 runs 次的平均
+struct MISTiming {
     std::vector<double> times;
-    std::cout << graphname << "    ";
-    for (int run = 1; run <= 3; run++) {
+    std::vector<std::pair<std::string, double>> phases;
+    size_t rounds = 0;
+    double avg() const { return std::accumulate(times.begin(), times.end(), 0.0) / times.size(); }
+};
+
+template <class Graph>
+MISTiming time_mis(const Graph& G, MISWorkspace<typename Graph::NodeId>& ws, int runs = 3) {
+    // Warm up（顺便把工作区分配好、排列生成好）
+    { auto tmp = MIS(G, ws); }
+    // Test
+    MISTiming timing;
+    PhaseProfile prof;
+    for (int run = 1; run <= runs; run++) {
         internal::timer t;
-        auto mis_set = MIS(G);
+        auto mis_set = MIS(G, ws, 0, &prof);
         t.stop();
-        times.push_back(t.total_time());
+        timing.times.push_back(t.total_time());
+        for (auto& [name, sample] : prof.phase_records()) {
+            auto it = std::find_if(timing.phases.begin(), timing.phases.end(),
+                                   [&](auto& ph) { return ph.first == name; });
+            if (it == timing.phases.end()) timing.phases.emplace_back(name, sample.seconds / runs);
+            else it->second += sample.seconds / runs;
+        }
+        timing.rounds = prof.rounds();
+    }
+    return timing;
+}
+
+// Scaling: 同一张图（文件或隐式图）、同一个排列（seed 0）在 1, 2, 4, ..., P 个 worker 上各跑一遍 time_mis
+// 先每核一个线程（不用超线程），再把每个核的超线程都用上；加速比都相对 1 个 worker
+int scaling_sweep(const char* filename, size_t max_workers) {
+    std::string graphname = std::filesystem::path(filename).stem().string();
+    CpuTopology topo = detect_topology();
+    size_t cores = topo.cores();
+    if (max_workers != 0) cores = std::min(cores, max_workers);
+    std::vector<std::string> args = {"mis", filename, "--scale-child"};
+
+    struct Row { std::string mode; size_t workers; std::map<std::string, double> t; };
+    std::vector<Row> rows;
+    auto run = [&](const std::string& mode, size_t workers, const std::vector<int>& cpus) {
+        std::string out = run_pinned_child(args, workers, cpus);
+        std::istringstream lines(out);
+        std::string line;
+        while (std::getline(lines, line)) {
+            if (line.rfind("SCALE ", 0) != 0) continue;
+            Row row{mode, workers, {}};
+            std::istringstream tokens(line.substr(6));
+            std::string kv;
+            while (tokens >> kv) {
+                size_t eq = kv.find('=');
+                if (eq != std::string::npos) row.t[kv.substr(0, eq)] = std::atof(kv.c_str() + eq + 1);
+            }
+            rows.push_back(row);
+            std::cerr << "  " << mode << " workers=" << workers << " total=" << row.t["total"] << "s" << std::endl;
+        }
+    };
+    for (size_t p : worker_counts(1, cores)) {
+        run("cores", p, std::vector<int>(topo.primary.begin(), topo.primary.begin() + p));
+    }
+    if (topo.has_smt()) {
+        for (size_t c : worker_counts(1, cores)) {
+            std::vector<int> cpus;
+            for (size_t i = 0; i < c; i++) cpus.insert(cpus.end(), topo.siblings[i].begin(), topo.siblings[i].end());
+            run("smt", cpus.size(), cpus);
+        }
+    } else {
+        std::cerr << "No hyperthreads detected, skipping the SMT sweep" << std::endl;
+    }
+    if (rows.empty() || rows[0].workers != 1) {
+        std::cerr << "Error: single-worker baseline failed" << std::endl;
+        return 1;
+    }
+
+    // 低于 50% 效率记为 inefficient；加 worker 后反而没变快记为 collapse
+    const std::vector<std::string> phases = {"total", "counter_init", "frontier", "extract"};
+    std::map<std::string, double> base = rows[0].t;
+    std::filesystem::create_directories("./results");
+    std::ofstream csv("./results/" + graphname + "_scaling.csv");
+    csv << "mode,workers";
+    for (auto& ph : phases) csv << "," << ph << "_s," << ph << "_speedup," << ph << "_efficiency";
+    csv << ",rounds,flags\n";
+    std::cout << graphname << " scaling (self-relative to 1 worker)\n";
+    std::cout << std::left << std::setw(7) << "mode" << std::right << std::setw(8) << "workers";
+    for (auto& ph : phases) std::cout << std::setw(26) << (ph + " s/x/eff");
+    std::cout << "  flags\n";
+    std::map<std::string, std::map<std::string, double>> prev_speedup;
+    for (auto& row : rows) {
+        std::string flags;
+        csv << row.mode << "," << row.workers;
+        std::cout << std::left << std::setw(7) << row.mode << std::right << std::setw(8) << row.workers;
+        for (auto& ph : phases) {
+            double t = row.t[ph];
+            double speedup = t > 0 ? base[ph] / t : 0;
+            double eff = speedup / row.workers;
+            csv << "," << t << "," << speedup << "," << eff;
+            std::ostringstream cell;
+            cell << std::setprecision(3) << t << "/" << speedup << "x/" << std::setprecision(2) << eff * 100 << "%";
+            std::cout << std::setw(26) << cell.str();
+            auto& prev = prev_speedup[row.mode];
+            if (row.workers > 1 && eff < 0.5) flags += " inefficient:" + ph;
+            if (prev.count(ph) && speedup <= prev[ph]) flags += " collapse:" + ph;
+            prev[ph] = speedup;
+        }
+        csv << "," << row.t["rounds"] << "," << flags << "\n";
+        std::cout << " " << flags << "\n";
+    }
+    return 0;
+}
+
+// Init: 单独测计数器初始化那一遍（每条边一次 gather + 比较），各 SIMD 内核对比，
+// 再给出整个 MIS 里 counter_init 和轮次循环各占多少
+template <class Graph>
+int init_bench(const Graph& G, MISWorkspace<typename Graph::NodeId>& ws, int runs = 5) {
+    using NodeId = typename Graph::NodeId;
+    size_t n = G.n;
+    auto priority = parlay::random_permutation<NodeId>(n, 0);
+    parlay::sequence<uint32_t> reference, counts(n);
+    double scalar_time = 0;
+    SimdLevel best = detect_simd_level();
+    std::cout << "counter init  n=" << n << " m=" << G.m << "  default kernel " << simd_level_name(simd_level())
+              << std::endl;
+    for (int l = SIMD_SCALAR; l <= best; l++) {
+        SimdLevel level = static_cast<SimdLevel>(l);
+        auto count_all = [&] {
+            parlay::parallel_for(0, n, [&](size_t u) {
+                counts[u] = count_neighbors_before(G, priority.begin(), static_cast<NodeId>(u), true, level);
+            });
+        };
+        count_all();  // Warm up
+        double t_best = 0;
+        for (int run = 0; run < runs; run++) {
+            internal::timer t;
+            count_all();
+            t.stop();
+            if (run == 0 || t.total_time() < t_best) t_best = t.total_time();
+        }
+        if (level == SIMD_SCALAR) {
+            reference = counts;
+            scalar_time = t_best;
+        }
+        std::cout << "    " << std::left << std::setw(7) << simd_level_name(level) << std::right << "  " << t_best
+                  << "s  " << t_best * 1e9 / std::max<size_t>(G.m, 1) << " ns/edge  x" << scalar_time / t_best
+                  << (counts == reference ? "" : "  (COUNTS DIFFER from scalar)") << std::endl;
+    }
+    MISTiming timing = time_mis(G, ws);
+    double init = 0;
+    for (auto& [name, secs] : timing.phases) {
+        if (name == "counter_init") init = secs;
+    }
+    std::cout << "MIS " << timing.avg() << "s  counter_init " << init << "s  rounds " << timing.avg() - init << "s"
+              << std::endl;
+    return 0;
+}
+
+// TSC 每秒多少个 tick（和 steady_clock 对 50ms 校准一次）；没有硬件计数器时用它估算周期
+inline double tsc_hz() {
+#if defined(__x86_64__) || defined(__i386__)
+    static double hz = [] {
+        auto t0 = std::chrono::steady_clock::now();
+        uint64_t c0 = __builtin_ia32_rdtsc();
+        while (std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(50)) {}
+        uint64_t c1 = __builtin_ia32_rdtsc();
+        return (c1 - c0) / std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    }();
+    return hz;
+#else
+    return 0;
+#endif
+}
+
+// Traversal: direct 和不同 group 的 amac 对比轮次循环（frontier 阶段）的时间，
+// 换算成每条两跳边（被删掉的 v 的每个邻居 w 算一条）的周期数。周期优先用硬件计数器
+// （所有线程的 cycles 之和），拿不到时用 TSC × worker 数估算
+template <class Graph>
+int traversal_bench(const Graph& G, MISWorkspace<typename Graph::NodeId>& ws) {
+    using NodeId = typename Graph::NodeId;
+    struct Config { Traversal traversal; size_t group; };
+    std::vector<Config> configs = {{TRAVERSAL_DIRECT, 0}};
+    for (size_t g : {4, 8, 16, 32, 64}) configs.push_back({TRAVERSAL_AMAC, g});
+    MISOptions saved = ws.options;
+    PhaseProfile pmu_prof(true);
+    size_t two_hop = 0;
+    double direct_cycles = 0;
+    for (auto& c : configs) {
+        ws.options.traversal = c.traversal;
+        ws.options.amac_group = c.group ? c.group : saved.amac_group;
+        MISTiming timing = time_mis(G, ws);
+        double rounds_time = 0;
+        for (auto& [name, secs] : timing.phases) {
+            if (name == "frontier") rounds_time = secs;
+        }
+        // 两跳边数：和遍历方式无关，算一次
+        if (two_hop == 0) {
+            auto removed = parlay::delayed_seq<size_t>(G.n, [&](size_t v) {
+                return ws.status[v].load() == REMOVED ? G.degree(static_cast<NodeId>(v)) : 0;
+            });
+            two_hop = std::max<size_t>(parlay::reduce(removed), 1);
+        }
+        auto mis_set = MIS(G, ws, 0, &pmu_prof);
+        double cycles = 0;
+        std::string unit = "cycles";
+        for (auto& [name, sample] : pmu_prof.phase_records()) {
+            if (name == "frontier" && pmu_prof.pmu_enabled()) cycles = sample.counts[PERF_CYCLES];
+        }
+        if (cycles == 0) {
+            cycles = rounds_time * tsc_hz() * parlay::num_workers();
+            unit = "tsc-cycles";
+        }
+        if (c.traversal == TRAVERSAL_DIRECT) direct_cycles = cycles;
+        std::cout << "    " << std::left << std::setw(7) << traversal_name(c.traversal) << std::right << std::setw(4)
+                  << (c.group ? std::to_string(c.group) : "") << "  rounds " << rounds_time << "s  "
+                  << cycles / two_hop << " " << unit << "/two-hop edge  x" << direct_cycles / cycles << std::endl;
+    }
+    std::cout << "two-hop edges " << two_hop << "  workers " << parlay::num_workers() << std::endl;
+    ws.options = saved;
+    return 0;
+}
+
+// Tail: 按未决定顶点数的阈值扫一遍（0 = 不启用），看尾部串行能省多少轮、多少时间，结果和不启用时比对
+template <class Graph>
+int tail_bench(const Graph& G, MISWorkspace<typename Graph::NodeId>& ws) {
+    MISOptions saved = ws.options;
+    ws.options.tail_vertices = ws.options.tail_edges = 0;
+    auto reference = MIS(G, ws);
+    std::cout << "tail threshold (undecided vertices)  n=" << G.n << std::endl;
+    for (size_t div : {0, 10000, 1000, 100, 10}) {
+        ws.options.tail_vertices = div ? std::max<size_t>(G.n / div, 1) : 0;
+        MISTiming timing = time_mis(G, ws);
+        bool same = MIS(G, ws) == reference;
+        std::cout << "    " << std::setw(10) << ws.options.tail_vertices << "  " << timing.avg() << "s  parallel rounds "
+                  << timing.rounds << "  tail " << ws.tail_size << " vertices, " << ws.tail_rounds_saved
+                  << " rounds saved" << (same ? "" : "  (MIS DIFFERS)") << std::endl;
+    }
+    ws.options = saved;
+    return 0;
+}
+
+// Compact: 按 MIS_COMPACT 的比例扫一遍（0 = 不压缩），看轮次循环（frontier + compact 阶段）省多少时间，
+// 每次压缩后剩多少点和边，结果和不压缩时比对
+template <class Graph>
+int compact_bench(const Graph& G, MISWorkspace<typename Graph::NodeId>& ws) {
+    MISOptions saved = ws.options;
+    ws.options.compact = 0;
+    auto reference = MIS(G, ws);
+    std::cout << "compact fraction  n=" << G.n << " m=" << G.m << std::endl;
+    for (double f : {0.0, 0.5, 0.75, 0.9}) {
+        ws.options.compact = f;
+        MISTiming timing = time_mis(G, ws);
+        double rounds_time = 0, compact_time = 0;
+        for (auto& [name, secs] : timing.phases) {
+            if (name == "frontier") rounds_time = secs;
+            if (name == "compact") compact_time = secs;
+        }
+        bool same = MIS(G, ws) == reference;
+        std::cout << "    " << std::setw(5) << f << "  " << timing.avg() << "s  rounds " << rounds_time << "s  compact "
+                  << compact_time << "s" << (same ? "" : "  (MIS DIFFERS)") << std::endl;
+        for (auto& [cn, cm] : ws.compactions) std::cout << "        -> n=" << cn << " m=" << cm << std::endl;
+    }
+    ws.options = saved;
+    return 0;
+}
+
+// Priority: 每种优先级策略各跑一遍。cold 是新工作区上的第一次调用（分配 + 生成排名都算在里面，degeneracy 还有剥离），
+// warm 是 time_mis 的平均；counter_init 是计数那一遍（存排名时按邻居 gather priority，hash 时现算）；
+// rounds 是并行轮数，|MIS| 看哪种策略选得多
+template <class Graph>
+int priority_bench(const Graph& G, MISWorkspace<typename Graph::NodeId>& ws) {
+    using NodeId = typename Graph::NodeId;
+    MISOptions saved = ws.options;
+    std::cout << "priority  n=" << G.n << " m=" << G.m << std::endl;
+    for (PriorityKind kind : kPriorityKinds) {
+        MISWorkspace<NodeId> cold_ws;
+        cold_ws.options = saved;
+        cold_ws.options.priority = kind;
+        internal::timer t;
+        size_t size = MIS(G, cold_ws).size();
+        double cold = t.next_time();
+        ws.options = cold_ws.options;
+        MISTiming timing = time_mis(G, ws);
+        double init = 0;
+        for (auto& [name, secs] : timing.phases) {
+            if (name == "counter_init") init = secs;
+        }
+        std::cout << "    " << std::left << std::setw(10) << priority_kind_name(kind) << std::right << "  cold "
+                  << cold << "s  warm " << timing.avg() << "s  counter_init " << init << "s  rounds " << timing.rounds
+                  << "  |MIS| " << size << "  priority array " << cold_ws.priority.size() * sizeof(NodeId) << " bytes" << std::endl;
+    }
+    ws.options = saved;
+    return 0;
+}
+
+template <class Graph>
+int run(const Graph& G, const std::string& graphname, int argc, char* argv[]) {
+    std::string mode = argc >= 3 ? argv[2] : "";
+    // 所有调用共用一个工作区，计时只包含算法本身
+    MISWorkspace<typename Graph::NodeId> ws;
+    if (mode == "--scale-child") {
+        MISTiming timing = time_mis(G, ws);
+        std::cout << "SCALE total=" << timing.avg();
+        for (auto& [name, secs] : timing.phases) std::cout << " " << name << "=" << secs;
+        std::cout << " rounds=" << timing.rounds << std::endl;
+        return 0;
+    }
+    if (mode == "--init") return init_bench(G, ws);
+    if (mode == "--traversal") return traversal_bench(G, ws);
+    if (mode == "--tail") return tail_bench(G, ws);
+    if (mode == "--compact") return compact_bench(G, ws);
+    if (mode == "--priority") return priority_bench(G, ws);
+    std::cout << graphname << "    ";
+    MISTiming timing = time_mis(G, ws);
+    auto& times = timing.times;
+    std::cout << timing.avg() << "s = avg(" << times[0] << ", " << times[1] << ", "  << times[2] << ")\n";
+    if (ws.tail_size) {
+        std::cout << "tail: " << ws.tail_size << " vertices finished serially, " << ws.tail_rounds_saved
+                  << " rounds saved (" << timing.rounds << " parallel rounds)\n";
+    }
+    if (!ws.compactions.empty()) {
+        std::cout << "compacted " << ws.compactions.size() << " times, last to n=" << ws.compactions.back().first
+                  << " m=" << ws.compactions.back().second << "\n";
     }
-    double avg_time = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
-    std::cout << avg_time << "s = avg(" << times[0] << ", " << times[1] << ", "  << times[2] << ")\n";
     // Verify
     bool verify = false;
-    if (argc == 3) verify = (std::atoi(argv[2]) != 0);
+    if (argc >= 3) verify = (std::atoi(argv[2]) != 0);
     if (verify) {
-        auto mis_set = MIS(G);
+        auto mis_set = MIS(G, ws);
         std::string output_file = "./results/" + graphname + ".txt";
         save_mis_to_file(mis_set, output_file);
     }
+    // Perf: 单独跑一次带硬件计数器的 MIS，不影响上面的计时
+    bool perf = false;
+    if (argc == 4) perf = (std::atoi(argv[3]) != 0);
+    if (perf) {
+        PhaseProfile prof(true);
+        auto mis_set = MIS(G, ws, 0, &prof);
+        prof.report(std::cout);
+        ws.report_memory(std::cout);
+        if constexpr (requires { G.offsets.begin(); }) {
+            report_page_usage(std::cout, "offsets", G.offsets.begin(), (G.n + 1) * sizeof(G.offsets[0]));
+            report_page_usage(std::cout, "edges", G.edges.begin(), G.m * sizeof(G.edges[0]));
+        }
+        std::filesystem::create_directories("./perf");
+        prof.write_rounds("./perf/" + graphname + ".csv");
+    }
     return 0;
-}
\ No newline at end of file
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 4) {
+        std::cerr << "Usage: ./mis input_graph [verify] [perf]\n"
+                  << "       ./mis input_graph --scale [max_cores]\n"
+                  << "       ./mis input_graph --init      (counter init per SIMD kernel; MIS_SIMD forces one)\n"
+                  << "       ./mis input_graph --traversal (round loop per traversal; MIS_TRAVERSAL=direct|amac)\n"
+                  << "       ./mis input_graph --tail      (serial tail thresholds; MIS_TAIL_VERTICES / MIS_TAIL_EDGES)\n"
+                  << "       ./mis input_graph --compact   (undecided-subgraph compaction; MIS_COMPACT=fraction)\n"
+                  << "       ./mis input_graph --priority  (priority strategies; MIS_PRIORITY=perm|hash|degree|degeneracy)\n"
+                  << "input_graph: a .bin/.adj file, shm:<name> (see tools/shm_graph), or an implicit graph\n"
+                  << "             grid:<rows>x<cols> | torus:<rows>x<cols> | circulant:<n>:<s1>,<s2>,..." << std::endl;
+        return 1;
+    }
+    const char* filename = argv[1];
+    std::string mode = argc >= 3 ? argv[2] : "";
+    if (mode == "--scale") return scaling_sweep(filename, argc == 4 ? std::atoi(argv[3]) : 0);
+    // 隐式图：邻居现算，不存 CSR；结果文件名里的 ':' 换成 '_'
+    int ret = 0;
+    std::string spec = filename;
+    std::string implicit_name = spec;
+    std::replace(implicit_name.begin(), implicit_name.end(), ':', '_');
+    std::replace(implicit_name.begin(), implicit_name.end(), ',', '_');
+    if (with_implicit_graph(spec, [&](const auto& G) { ret = run(G, implicit_name, argc, argv); })) {
+        return ret;
+    }
+    // shm:<name>：挂载 tools/shm_graph 常驻的图，O(1)
+    if (spec.rfind("shm:", 0) == 0) {
+        GraphView<uint32_t, uint64_t> G;
+        G.attach(spec.substr(4));
+        return run(G, std::filesystem::path(spec.substr(4)).stem().string(), argc, argv);
+    }
+    Graph<uint32_t, uint64_t> G;
+    G.read_graph(filename);
+    if (!G.symmetrized) { G = make_symmetrized(G); }
+    return run(G, std::filesystem::path(filename).stem().string(), argc, argv);
+}
@@ -0,0 +1,516 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+#include "parlay/random.h"
+#include "alloc_policy.h"
+#include "compact_graph.h"
+#include "counter.h"
+#include "perf_counters.h"
+#include "priority.h"
+#include "simd_count.h"
+
+enum MISStatus : uint64_t { UNDECIDED = 0, SELECTED = 1, REMOVED = 2 };
+
+// 删除邻居那一步（frontier → v → w 两跳）的遍历方式，运行时用环境变量选：
+//   MIS_TRAVERSAL  = direct | amac   (默认 direct)
+//   MIS_AMAC_GROUP = 每个线程同时在途的邻居数 (默认 16，最多 kMaxAmacGroup)
+// direct 一个邻居一个邻居走，edges → status → offsets → priority → counter 全是串行依赖的随机读；
+// amac 让每个线程轮流推进 group 个小状态机，每一步先 prefetch 下一步要读的位置，多个 cache miss 重叠。
+// 只对 CSR 图生效，隐式图总是 direct。
+//
+// 尾部：剩下的未决定顶点数（或它们的度数和）不超过阈值时，不再一轮一轮 fork/join，
+// 把剩下的顶点按优先级排好串行贪心扫完（答案不变，还是字典序最小的 MIS）：
+//   MIS_TAIL_VERTICES = 未决定顶点数阈值     (默认 0，不启用)
+//   MIS_TAIL_EDGES    = 未决定顶点度数和阈值 (默认 0，不启用)
+//
+// 优先级：MIS_PRIORITY = perm | hash | degree | degeneracy（见 priority.h，默认 perm）。hash 不存排列，比较时现算，
+// 省掉生成排列的那一遍和 n 大小的 priority 数组；degree / degeneracy 按度数 / 剥离层次量化成 32 位的键再排名，
+// 低度数的点先选，MIS 通常更大，轮数看图的结构。换了优先级，MIS 自然也不一样。
+//
+// 压缩：已决定的顶点占当前图的比例达到 MIS_COMPACT（见 compact_graph.h，默认 0 不启用）时，
+// 把未决定顶点和它们之间的边重新打包成一个小 CSR，后面的轮次在小图上跑，不再扫已决定的邻居。
+enum Traversal { TRAVERSAL_DIRECT, TRAVERSAL_AMAC };
+constexpr size_t kMaxAmacGroup = 64;
+
+struct MISOptions {
+    Traversal traversal = TRAVERSAL_DIRECT;
+    size_t amac_group = 16;
+    size_t tail_vertices = 0;
+    size_t tail_edges = 0;
+    double compact = compact_fraction_from_env();
+    PriorityKind priority = priority_kind_from_env();
+
+    bool tail_enabled() const { return tail_vertices > 0 || tail_edges > 0; }
+    bool compact_enabled() const { return compact > 0; }
+
+    static MISOptions from_env() {
+        MISOptions opt;
+        if (const char* s = std::getenv("MIS_TRAVERSAL")) {
+            std::string v(s);
+            if (v == "amac") opt.traversal = TRAVERSAL_AMAC;
+            else if (v != "direct") std::cerr << "Warning: unknown MIS_TRAVERSAL=" << v << ", using direct" << std::endl;
+        }
+        if (const char* s = std::getenv("MIS_AMAC_GROUP")) {
+            opt.amac_group = std::clamp<size_t>(std::strtoull(s, nullptr, 10), 1, kMaxAmacGroup);
+        }
+        if (const char* s = std::getenv("MIS_TAIL_VERTICES")) opt.tail_vertices = std::strtoull(s, nullptr, 10);
+        if (const char* s = std::getenv("MIS_TAIL_EDGES")) opt.tail_edges = std::strtoull(s, nullptr, 10);
+        return opt;
+    }
+};
+
+inline const char* traversal_name(Traversal t) { return t == TRAVERSAL_AMAC ? "amac" : "direct"; }
+
+// MIS 的工作区：status / priority / counter 和两个 frontier 缓冲区都是 n 大小，跨调用复用（priority 只有存排列时才分配）。
+// 每次调用时 status 和 counter 在计数的那一遍里顺便重置；同一个 seed 的排列直接沿用，
+// 所以重复查询（warm up、计时、verify）不再分配内存，也不用重新生成排列。
+// 这些数组按 policy（MIS_PAGES / MIS_NUMA，见 alloc_policy.h）选页大小和 NUMA 放置。
+template <class NodeId>
+struct MISWorkspace {
+    size_t n = 0;
+    AllocPolicy policy = AllocPolicy::from_env();
+    MISOptions options = MISOptions::from_env();
+    PolicyArray<std::atomic<uint64_t>> status;          // status:  顶点当前的状态
+    PolicyArray<NodeId> priority;                       // priority: 0..n-1 的排名，越小优先级越高（MIS_PRIORITY 不是 hash 时）
+    PolicyArray<Counter> counter;
+    PolicyArray<NodeId> frontier;                       // 本轮 frontier（前 frontier_size 个有效）
+    PolicyArray<NodeId> next_frontier;                  // 下一轮 frontier 的写入空间
+    size_t priority_seed = 0;
+    PriorityKind priority_kind = PRIORITY_PERMUTATION;
+    GraphKey priority_graph;                            // degree / degeneracy 的排名和图有关，换了图要重算（见 priority.h）
+    bool has_priority = false;
+    // 上一次调用的尾部统计：串行扫完的顶点数、省掉的并行轮数（没进尾部时都是 0）
+    size_t tail_size = 0;
+    size_t tail_rounds_saved = 0;
+    // 上一次调用每次压缩后的图大小（顶点数，边数），按先后顺序
+    std::vector<std::pair<size_t, size_t>> compactions;
+    // 压缩后的图用的工作区；同一个 seed 每次压缩出的大小一样，所以重复调用也不重新分配
+    std::unique_ptr<MISWorkspace> compacted;
+
+    // 大小变了才重新分配，返回是否重新分配了
+    bool resize(size_t _n) {
+        if (_n == n) return false;
+        n = _n;
+        status = PolicyArray<std::atomic<uint64_t>>(n, policy);
+        counter = PolicyArray<Counter>(n, policy);
+        frontier = PolicyArray<NodeId>(n, policy);
+        next_frontier = PolicyArray<NodeId>(n, policy);
+        return true;
+    }
+
+    // priority 数组（存排列或压缩时抄过来的优先级），大小不对才重新分配
+    void ensure_priority() {
+        if (priority.size() == n) return;
+        priority = PolicyArray<NodeId>(n, policy);
+        has_priority = false;
+    }
+
+    // 存排名的路径：同一个 seed、同一种优先级（degree / degeneracy 还要同一张图）的排名只生成一次。
+    // 图按 GraphKey 认（地址、n、m、度数抽样、更新次数），原地改了边但这些都没变时调用方要自己把 has_priority 清掉
+    template <class Graph>
+    void prepare(const Graph& G, size_t seed) {
+        resize(G.n);
+        ensure_priority();
+        PriorityKind kind = options.priority;
+        GraphKey graph = kind == PRIORITY_PERMUTATION ? GraphKey{} : GraphKey::of(G);
+        if (!has_priority || priority_seed != seed || priority_kind != kind || priority_graph != graph) {
+            stored_ranks(G, kind, seed, priority.begin());
+            priority_seed = seed;
+            priority_kind = kind;
+            priority_graph = graph;
+            has_priority = true;
+        }
+    }
+
+    // 每个数组实际拿到的页大小、THP 覆盖和 NUMA 分布
+    void report_memory(std::ostream& os) const {
+        os << "workspace pages=" << page_policy_name(policy.pages)
+           << " numa=" << (policy.numa == NUMA_INTERLEAVE ? "interleave" : "firsttouch") << "\n";
+        report_page_usage(os, "status", status.begin(), n * sizeof(uint64_t));
+        if (priority.size()) report_page_usage(os, "priority", priority.begin(), n * sizeof(NodeId));
+        report_page_usage(os, "counter", counter.begin(), n * sizeof(Counter));
+        report_page_usage(os, "frontier", frontier.begin(), n * sizeof(NodeId));
+        report_page_usage(os, "next_frontier", next_frontier.begin(), n * sizeof(NodeId));
+    }
+};
+
+// AMAC 版的两跳删除：us[0..count) 是一段 frontier，依次取出它们的邻居 v 交给空闲的槽。
+// 每个槽是一个状态机：
+//   IDLE    取下一个 v，prefetch status[v] / offsets[v] / priority[v]（存排列时）
+//   CLAIM_V CAS status[v] 为 REMOVED，成功才去遍历 v 的邻居，prefetch v 的边
+//   FETCH_W 读下一个 w，prefetch status[w] / priority[w] / counter[w]
+//   VISIT_W 检查 w，计数器从 1 变 0 时 push(w)
+// 槽轮流各走一步，直到输入取完、所有槽都空闲。操作和 direct 完全一样（同样的 CAS 和原子减），只是顺序交错。
+// 返回这一段删掉的顶点数和它们的度数和。
+template <class Graph, class Rank, class Push>
+std::pair<size_t, size_t> remove_neighbors_amac(const Graph& G, MISWorkspace<typename Graph::NodeId>& ws,
+                           const Rank& rank, const typename Graph::NodeId* us, size_t count, size_t group,
+                           Push&& push) {
+    using NodeId = typename Graph::NodeId;
+    using EdgeId = std::decay_t<decltype(G.offsets[0])>;
+    using Key = decltype(rank(NodeId()));
+    constexpr bool stored = !std::is_same_v<Rank, HashRank>;
+    enum Stage { IDLE, CLAIM_V, FETCH_W, VISIT_W, DONE };
+    struct Slot {
+        Stage stage;
+        NodeId v, w;
+        Key pv;
+        EdgeId e, end;
+    };
+    auto& status = ws.status;
+    auto& counter = ws.counter;
+    group = std::clamp<size_t>(group, 1, kMaxAmacGroup);
+    Slot slots[kMaxAmacGroup];
+    for (size_t s = 0; s < group; s++) slots[s].stage = IDLE;
+
+    // 输入流：us[i] 的邻接表里下一个 v
+    size_t i = 0;
+    EdgeId next = 0, last = 0;
+    if (count > 0) {
+        next = G.offsets[us[0]];
+        last = G.offsets[us[0] + 1];
+    }
+    auto next_v = [&](NodeId& v) {
+        while (next == last) {
+            if (++i >= count) return false;
+            next = G.offsets[us[i]];
+            last = G.offsets[us[i] + 1];
+        }
+        v = G.edges[next++].v;
+        return true;
+    };
+
+    size_t removed = 0, removed_degree = 0;
+    size_t live = group;
+    while (live > 0) {
+        for (size_t s = 0; s < group; s++) {
+            Slot& sl = slots[s];
+            switch (sl.stage) {
+                case IDLE:
+                    if (next_v(sl.v)) {
+                        __builtin_prefetch(&status[sl.v], 1);
+                        __builtin_prefetch(&G.offsets[sl.v]);
+                        if constexpr (stored) __builtin_prefetch(&rank.ranks[sl.v]);
+                        sl.stage = CLAIM_V;
+                    } else {
+                        sl.stage = DONE;
+                        live--;
+                    }
+                    break;
+                case CLAIM_V: {
+                    uint64_t expected = UNDECIDED;
+                    if (status[sl.v].compare_exchange_strong(expected, REMOVED)) {
+                        sl.e = G.offsets[sl.v];
+                        sl.end = G.offsets[sl.v + 1];
+                        sl.pv = rank(sl.v);
+                        removed++;
+                        removed_degree += sl.end - sl.e;
+                        if (sl.e != sl.end) __builtin_prefetch(&G.edges[sl.e]);
+                        sl.stage = FETCH_W;
+                    } else {
+                        sl.stage = IDLE;
+                    }
+                    break;
+                }
+                case FETCH_W:
+                    if (sl.e == sl.end) {
+                        sl.stage = IDLE;
+                        break;
+                    }
+                    sl.w = G.edges[sl.e++].v;
+                    __builtin_prefetch(&status[sl.w]);
+                    if constexpr (stored) __builtin_prefetch(&rank.ranks[sl.w]);
+                    __builtin_prefetch(&counter[sl.w], 1);
+                    sl.stage = VISIT_W;
+                    break;
+                case VISIT_W:
+                    if (status[sl.w].load() == UNDECIDED && rank(sl.w) > sl.pv) {
+                        if (counter[sl.w].decrement_to_zero()) push(sl.w);
+                    }
+                    sl.stage = FETCH_W;
+                    break;
+                case DONE:
+                    break;
+            }
+        }
+    }
+    return {removed, removed_degree};
+}
+
+// 尾部：status 还是 UNDECIDED 的顶点按优先级串行贪心。没有被删的就入选，再删掉它的未决定邻居。
+// 顺便精确算出并行循环本来还要跑几轮：当前 frontier 是第 1 轮；入选点的轮数 = 1 + 比它优先的
+// （尾部里被删的）邻居的删除轮数的最大值；被删点的轮数 = 比它优先的入选邻居的轮数的最小值
+// （比它后的入选邻居轮数一定更大）。这些只依赖更优先的顶点，所以按优先级一遍就能算完。
+// 返回省掉的轮数。
+template <class Graph, class Rank>
+size_t finish_tail_sequential(const Graph& G, MISWorkspace<typename Graph::NodeId>& ws, const Rank& rank) {
+    using NodeId = typename Graph::NodeId;
+    auto& status = ws.status;
+    auto tail = parlay::filter(parlay::iota<NodeId>(G.n), [&](NodeId u) {
+        return status[u].load(std::memory_order_relaxed) == UNDECIDED;
+    });
+    std::sort(tail.begin(), tail.end(), [&](NodeId a, NodeId b) { return rank(a) < rank(b); });
+    // next_frontier 这时已经没用了，拿来当稀疏集合：pos[u] 是 u 在 tail 里的下标，
+    // 只有 tail[pos[u]] == u 时才有效，不用初始化
+    auto& pos = ws.next_frontier;
+    for (size_t i = 0; i < tail.size(); i++) pos[tail[i]] = static_cast<NodeId>(i);
+    auto in_tail = [&](NodeId v) { return pos[v] < tail.size() && tail[pos[v]] == v; };
+    std::vector<size_t> round(tail.size(), 0);
+    size_t rounds = 0;
+    for (size_t i = 0; i < tail.size(); i++) {
+        NodeId u = tail[i];
+        if (status[u].load(std::memory_order_relaxed) != UNDECIDED) continue;
+        size_t r = 1;
+        G.map_neighbors(u, [&](NodeId v) {
+            if (in_tail(v) && rank(v) < rank(u)) r = std::max(r, round[pos[v]] + 1);
+        });
+        round[i] = r;
+        rounds = std::max(rounds, r);
+        status[u].store(SELECTED, std::memory_order_relaxed);
+        G.map_neighbors(u, [&](NodeId v) {
+            if (!in_tail(v) || rank(v) < rank(u)) return;
+            if (status[v].load(std::memory_order_relaxed) == UNDECIDED) {
+                status[v].store(REMOVED, std::memory_order_relaxed);
+                round[pos[v]] = r;
+            } else {
+                round[pos[v]] = std::min(round[pos[v]], r);
+            }
+        });
+    }
+    ws.tail_size = tail.size();
+    ws.tail_rounds_saved = rounds;
+    return rounds;
+}
+
+template <class Graph, class Rank>
+void mis_rounds(const Graph& G, MISWorkspace<typename Graph::NodeId>& ws, size_t frontier_size, const Rank& rank,
+                PhaseProfile* prof);
+
+// 压缩：未决定的顶点（包括当前 frontier）和它们之间的边打包成新 CSR，编号按原来的顺序重排。
+// 优先级照搬（hash 优先级也按原编号算好存下来，新图上是存下来的优先级）；计数器也照搬——还没被删的更优先邻居一定都是未决定的，所以计数对新图仍然准确。
+// 在新图上接着跑完，再把结果写回原来的编号。next_frontier 这时没用，拿来存旧编号到新编号的映射。
+template <class Graph, class Rank>
+void compact_and_continue(const Graph& G, MISWorkspace<typename Graph::NodeId>& ws, size_t frontier_size,
+                          const Rank& rank, PhaseProfile* prof) {
+    using NodeId = typename Graph::NodeId;
+    auto& status = ws.status;
+    auto& remap = ws.next_frontier;
+    auto sub = compact_subgraph(G, [&](NodeId u) {
+        return status[u].load(std::memory_order_relaxed) == UNDECIDED;
+    }, remap.begin());
+    size_t k = sub.G.n;
+    if (!ws.compacted) ws.compacted = std::make_unique<MISWorkspace<NodeId>>();
+    auto& cws = *ws.compacted;
+    cws.options = ws.options;
+    cws.resize(k);
+    cws.ensure_priority();
+    cws.has_priority = false;   // 这里的优先级是从上一层抄的，不是某个 seed 生成的排列
+    parlay::parallel_for(0, k, [&](size_t i) {
+        NodeId u = sub.orig[i];
+        cws.status[i].store(UNDECIDED, std::memory_order_relaxed);
+        cws.priority[i] = static_cast<NodeId>(rank(u));
+        cws.counter[i].reset(ws.counter[u].get_approxmt());
+    });
+    parlay::parallel_for(0, frontier_size, [&](size_t i) { cws.frontier[i] = remap[ws.frontier[i]]; });
+    if (prof) prof->lap("compact");
+
+    mis_rounds(sub.G, cws, frontier_size, StoredRank<NodeId>{cws.priority.begin()}, prof);
+
+    parlay::parallel_for(0, k, [&](size_t i) {
+        status[sub.orig[i]].store(cws.status[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    });
+    ws.tail_size = cws.tail_size;
+    ws.tail_rounds_saved = cws.tail_rounds_saved;
+    ws.compactions.emplace_back(k, sub.G.m);
+    ws.compactions.insert(ws.compactions.end(), cws.compactions.begin(), cws.compactions.end());
+    if (prof) prof->lap("compact");
+}
+
+// 轮次循环：ws.frontier 的前 frontier_size 个是第一轮的 frontier，status / counter 已经初始化好
+template <class Graph, class Rank>
+void mis_rounds(const Graph& G, MISWorkspace<typename Graph::NodeId>& ws, size_t frontier_size, const Rank& rank,
+                PhaseProfile* prof) {
+    using NodeId = typename Graph::NodeId;
+    size_t n = G.n;
+    auto& status = ws.status;
+    auto& counter = ws.counter;
+
+    // 开了尾部模式或压缩才统计剩下的未决定顶点数和度数和
+    const MISOptions& opt = ws.options;
+    bool track = opt.tail_enabled() || opt.compact_enabled();
+    size_t undecided = n, undecided_degree = G.m;
+    ws.tail_size = ws.tail_rounds_saved = 0;
+    ws.compactions.clear();
+
+    while (frontier_size != 0) {
+        auto& frontier = ws.frontier;
+        auto& next_frontier = ws.next_frontier;
+
+        if (track && (undecided <= opt.tail_vertices || undecided_degree <= opt.tail_edges)) {
+            finish_tail_sequential(G, ws, rank);
+            if (prof) prof->lap("tail");
+            break;
+        }
+        if (track && should_compact(n, undecided, opt.compact)) {
+            compact_and_continue(G, ws, frontier_size, rank, prof);
+            break;
+        }
+
+        // step 1: frontier里面的点全部标记 Selected
+        parlay::parallel_for(0, frontier_size, [&](size_t i) {
+            status[frontier[i]].store(SELECTED, std::memory_order_relaxed);
+        });
+
+        // step 2: 下一轮 frontier 写进 next_frontier；每个点只会在计数器从 1 变 0 时写入一次，
+        // 所以 n 大小就够，也不需要排序去重
+        std::atomic<size_t> write_ptr = 0;
+        std::atomic<size_t> removed = 0, removed_degree = 0;
+        if (track) {
+            undecided -= frontier_size;
+            undecided_degree -= parlay::reduce(parlay::delayed_seq<size_t>(frontier_size, [&](size_t i) {
+                return G.degree(frontier[i]);
+            }));
+        }
+
+        auto push = [&](NodeId w) {
+            size_t pos = write_ptr.fetch_add(1);
+            next_frontier[pos] = w;
+        };
+        auto direct = [&] {
+            const size_t WIDTH = 10000;
+            for (size_t start = 0; start < frontier_size; start += WIDTH) {
+                size_t end = std::min(start + WIDTH, frontier_size);
+                // step 3: frontier的邻居全部设置为Removed, 邻居的邻居的计数器看情况调整
+                parlay::parallel_for(start, end, [&](size_t i) {
+                    NodeId u = frontier[i];
+                    size_t local = 0, local_degree = 0;
+                    // v: frontier的邻居
+                    G.map_neighbors(u, [&](NodeId v) {
+                        uint64_t expected = UNDECIDED;
+                        // 原子地访问邻居，避免两个线程重复工作
+                        if (status[v].compare_exchange_strong(expected, REMOVED)) {
+                            if (track) {
+                                local++;
+                                local_degree += G.degree(v);
+                            }
+                            // 只有成功设置了Removed的邻居能进来
+                            // 邻居的邻居中，如果优先级低，则计数器--
+                            // w: frontier的邻居的邻居
+                            auto pv = rank(v);
+                            G.map_neighbors(v, [&](NodeId w) {
+                                if (status[w].load() == UNDECIDED && rank(w) > pv) {
+                                    // 生成新的frontier
+                                    if (counter[w].decrement_to_zero()) push(w);
+                                }
+                            });
+                        }
+                    });
+                    if (local) {
+                        removed.fetch_add(local);
+                        removed_degree.fetch_add(local_degree);
+                    }
+                });
+            }
+        };
+        if constexpr (requires { G.offsets[0]; G.edges[0].v; }) {
+            if (opt.traversal == TRAVERSAL_AMAC) {
+                // step 3 (amac)：每个任务拿一小段 frontier 跑一组状态机
+                const size_t BLOCK = 64;
+                parlay::parallel_for(0, (frontier_size + BLOCK - 1) / BLOCK, [&](size_t b) {
+                    size_t lo = b * BLOCK, hi = std::min(frontier_size, lo + BLOCK);
+                    auto [r, d] = remove_neighbors_amac(G, ws, rank, frontier.begin() + lo, hi - lo, opt.amac_group, push);
+                    if (track && r) {
+                        removed.fetch_add(r);
+                        removed_degree.fetch_add(d);
+                    }
+                }, 1);
+            } else {
+                direct();
+            }
+        } else {
+            direct();
+        }
+
+        // step 4: 交换缓冲区，更新 frontier
+        undecided -= removed.load();
+        undecided_degree -= removed_degree.load();
+        if (prof) prof->lap_round(frontier_size);
+        std::swap(ws.frontier, ws.next_frontier);
+        frontier_size = write_ptr.load();
+    }
+}
+
+// 给定优先级跑一遍：计数、分轮、取结果。rank(u) 越小越优先，各顶点互不相同
+template <class Graph, class Rank>
+parlay::sequence<typename Graph::NodeId> mis_with_rank(const Graph& G, MISWorkspace<typename Graph::NodeId>& ws,
+                                                       const Rank& rank, PhaseProfile* prof) {
+    using NodeId = typename Graph::NodeId;
+    size_t n = G.n;
+    auto& status = ws.status;
+    auto& counter = ws.counter;
+    // counter: verified_value = 0, approxmt_count = 0, targeted_value = 顶点的邻居比他优先级更高并且未被处理的数量
+    // 存排列时计数用 simd_count.h 的 gather 比较（AVX2 / AVX-512 / 标量按 CPU 选），高度数顶点按边并行
+    parlay::parallel_for(0, n, [&](size_t u) {
+        int count = count_neighbors_before(G, rank, static_cast<NodeId>(u));
+        counter[u].reset(count);
+        status[u].store(UNDECIDED, std::memory_order_relaxed);
+    });
+    //show_counter(counter, n);
+    // frontier: 准备标记Selected的点，初始化为counter为0的
+    size_t frontier_size = parlay::filter_into_uninitialized(
+        parlay::iota<NodeId>(n), ws.frontier,
+        [&](NodeId u) { return counter[u].is_zero(); }
+    );
+    if (prof) prof->lap("counter_init");
+
+    mis_rounds(G, ws, frontier_size, rank, prof);
+
+    // 过滤出Selected，返回
+    auto mis = parlay::filter(parlay::iota<NodeId>(n), [&](NodeId u) {
+        return status[u] == SELECTED;
+    });
+    if (prof) prof->lap("extract");
+    return mis;
+}
+
+// seed 决定优先级排列；同一 seed 下结果是确定的（字典序最小的贪心 MIS）
+// Graph 可以是 CSR（graph.h）也可以是隐式图（implicit_graph.h），只用到 n、map_neighbors
+// prof 非空时按阶段（counter_init / frontier / tail / compact / extract）和逐轮记录时间与硬件计数
+template <class Graph>
+parlay::sequence<typename Graph::NodeId> MIS(const Graph& G, MISWorkspace<typename Graph::NodeId>& ws,
+                                             size_t seed = 0, PhaseProfile* prof = nullptr) {
+    using NodeId = typename Graph::NodeId;
+    if (prof) prof->start();
+    if (ws.options.priority == PRIORITY_HASH) {
+        ws.resize(G.n);
+        return mis_with_rank(G, ws, HashRank(G.n, seed), prof);
+    }
+    ws.prepare(G, seed);
+    return mis_with_rank(G, ws, StoredRank<NodeId>{ws.priority.begin()}, prof);
+}
+
+// 调用方给定优先级（比如重排前的排名搬到新编号上），不管 MIS_PRIORITY，也不动工作区里缓存的排名
+template <class Graph, class Rank>
+parlay::sequence<typename Graph::NodeId> MISWithRank(const Graph& G, MISWorkspace<typename Graph::NodeId>& ws,
+                                                     const Rank& rank, PhaseProfile* prof = nullptr) {
+    if (prof) prof->start();
+    ws.resize(G.n);
+    return mis_with_rank(G, ws, rank, prof);
+}
+
+// 一次性调用：临时工作区
+template <class Graph>
+parlay::sequence<typename Graph::NodeId> MIS(const Graph& G, size_t seed = 0, PhaseProfile* prof = nullptr) {
+    MISWorkspace<typename Graph::NodeId> ws;
+    return MIS(G, ws, seed, prof);
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern char** environ;
+
+// CPU 拓扑：每个物理核的第一个逻辑 CPU 在 primary，其余超线程在 smt[core]
+struct CpuTopology {
+    std::vector<int> primary;
+    std::vector<std::vector<int>> siblings;   // siblings[i]: 与 primary[i] 同核的逻辑 CPU（含自身）
+
+    size_t cores() const { return primary.size(); }
+    bool has_smt() const {
+        for (auto& s : siblings) if (s.size() > 1) return true;
+        return false;
+    }
+};
+
+inline int read_sysfs_int(const std::string& path, int fallback) {
+    std::ifstream fin(path);
+    int x;
+    if (fin >> x) return x;
+    return fallback;
+}
+
+// 只考虑当前进程允许运行的 CPU；读不到 sysfs 时每个 CPU 当作独立物理核
+inline CpuTopology detect_topology() {
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    sched_getaffinity(0, sizeof(mask), &mask);
+    std::map<std::pair<int, int>, std::vector<int>> cores;
+    std::vector<std::pair<int, int>> order;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &mask)) continue;
+        std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+        int pkg = read_sysfs_int(base + "physical_package_id", 0);
+        int core = read_sysfs_int(base + "core_id", cpu);
+        auto key = std::make_pair(pkg, core);
+        if (!cores.count(key)) order.push_back(key);
+        cores[key].push_back(cpu);
+    }
+    CpuTopology topo;
+    for (auto& key : order) {
+        topo.primary.push_back(cores[key][0]);
+        topo.siblings.push_back(cores[key]);
+    }
+    return topo;
+}
+
+// 以 PARLAY_NUM_THREADS=workers、绑定到 cpus 的方式重新执行本程序，返回子进程的标准输出
+// parlay 的线程池在进程内只初始化一次，所以每个线程数都要一个新进程
+inline std::string run_pinned_child(const std::vector<std::string>& args, size_t workers,
+                                    const std::vector<int>& cpus) {
+    std::vector<std::string> env_strings;
+    for (char** e = environ; *e; e++) {
+        if (std::strncmp(*e, "PARLAY_NUM_THREADS=", 19) != 0) env_strings.push_back(*e);
+    }
+    env_strings.push_back("PARLAY_NUM_THREADS=" + std::to_string(workers));
+    std::vector<char*> envp, argv;
+    for (auto& s : env_strings) envp.push_back(const_cast<char*>(s.c_str()));
+    envp.push_back(nullptr);
+    for (auto& s : args) argv.push_back(const_cast<char*>(s.c_str()));
+    argv.push_back(nullptr);
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (int cpu : cpus) CPU_SET(cpu, &mask);
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        std::perror("pipe");
+        return "";
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        std::perror("fork");
+        close(fds[0]);
+        close(fds[1]);
+        return "";
+    }
+    if (pid == 0) {
+        dup2(fds[1], STDOUT_FILENO);
+        close(fds[0]);
+        close(fds[1]);
+        sched_setaffinity(0, sizeof(mask), &mask);
+        execve("/proc/self/exe", argv.data(), envp.data());
+        _exit(127);
+    }
+    close(fds[1]);
+    std::string out;
+    char buf[4096];
+    ssize_t len;
+    while ((len = read(fds[0], buf, sizeof(buf))) > 0) out.append(buf, len);
+    close(fds[0]);
+    int wstatus = 0;
+    waitpid(pid, &wstatus, 0);
+    if (!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0) {
+        std::fprintf(stderr, "Error: scaling run with %zu workers failed\n", workers);
+        return "";
+    }
+    return out;
+}
+
+// 1, 2, 4, ..., 最后补上 max 本身
+inline std::vector<size_t> worker_counts(size_t start, size_t max) {
+    std::vector<size_t> counts;
+    for (size_t p = start; p < max; p *= 2) counts.push_back(p);
+    if (max >= start) counts.push_back(max);
+    return counts;
+}
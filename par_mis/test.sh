@@ -5,4 +5,9 @@ make
 #./mis ../testcases/bin/hugebubbles-00020_sym.bin 1
 #./mis ../testcases/bin/eu-2015-host.bin
 #./mis ../testcases/bin/sd_arc.bin
-#./mis ../testcases/bin/soc-LiveJournal1.bin
\ No newline at end of file
+#./mis ../testcases/bin/soc-LiveJournal1.bin
+#./mis ../testcases/bin/friendster.bin --init
+#./mis ../testcases/bin/friendster.bin --traversal
+#MIS_TAIL_VERTICES=10000 ./mis ../testcases/bin/hugebubbles-00020_sym.bin --tail
+#MIS_COMPACT=0.5 ./mis ../testcases/bin/friendster.bin --compact
+#./mis ../testcases/bin/friendster.bin --priority
@@ -0,0 +1,319 @@
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Hardware events sampled around MIS phases. Order matches kPerfEventNames.
+enum PerfEvent : int {
+  PERF_CYCLES = 0,
+  PERF_INSTRUCTIONS,
+  PERF_LLC_MISSES,
+  PERF_DTLB_MISSES,
+  PERF_BRANCH_MISSES,
+  PERF_NUM_EVENTS
+};
+
+inline constexpr const char *kPerfEventNames[PERF_NUM_EVENTS] = {
+    "cycles", "instructions", "llc_misses", "dtlb_misses", "branch_misses"};
+
+struct PerfSample {
+  double seconds = 0;
+  std::array<uint64_t, PERF_NUM_EVENTS> counts{};
+
+  PerfSample &operator+=(const PerfSample &rhs) {
+    seconds += rhs.seconds;
+    for (int i = 0; i < PERF_NUM_EVENTS; i++) counts[i] += rhs.counts[i];
+    return *this;
+  }
+  PerfSample operator-(const PerfSample &rhs) const {
+    PerfSample r;
+    r.seconds = seconds - rhs.seconds;
+    for (int i = 0; i < PERF_NUM_EVENTS; i++) {
+      // Multiplexed counts are scaled estimates and need not be monotonic;
+      // clamp instead of wrapping around.
+      r.counts[i] = counts[i] > rhs.counts[i] ? counts[i] - rhs.counts[i] : 0;
+    }
+    return r;
+  }
+};
+
+// Per-thread perf_event_open counters, summed over every thread of this
+// process. Threads are enumerated from /proc/self/task at construction, so
+// build it after the parlay worker pool exists (e.g. after reading the
+// graph). If an event cannot be opened (no PMU in a VM, perf_event_paranoid,
+// seccomp) it is reported as unavailable and reads as zero.
+class PerfCounters {
+ public:
+  PerfCounters() {
+    std::vector<pid_t> tids;
+    if (DIR *dir = opendir("/proc/self/task")) {
+      while (dirent *ent = readdir(dir)) {
+        if (ent->d_name[0] != '.') tids.push_back(std::atoi(ent->d_name));
+      }
+      closedir(dir);
+    }
+    if (tids.empty()) tids.push_back(0);
+    for (int ev = 0; ev < PERF_NUM_EVENTS; ev++) {
+      for (pid_t tid : tids) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        set_event(static_cast<PerfEvent>(ev), attr);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format =
+            PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        int fd = syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0);
+        if (fd == -1) {
+          error[ev] = errno;
+          continue;  // the thread exited or refused; keep the others
+        }
+        fds[ev].push_back(fd);
+      }
+      if (!fds[ev].empty()) error[ev] = 0;
+    }
+    for (int ev = 0; ev < PERF_NUM_EVENTS; ev++) {
+      if (!fds[ev].empty()) any_available = true;
+    }
+  }
+
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  ~PerfCounters() {
+    for (auto &v : fds) {
+      for (int fd : v) close(fd);
+    }
+  }
+
+  bool available() const { return any_available; }
+  bool available(int ev) const { return !fds[ev].empty(); }
+  int open_error(int ev) const { return error[ev]; }
+
+  // Cumulative counts since construction, scaled for multiplexing.
+  PerfSample read() const {
+    PerfSample s;
+    s.seconds = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now().time_since_epoch())
+                    .count();
+    for (int ev = 0; ev < PERF_NUM_EVENTS; ev++) {
+      for (int fd : fds[ev]) {
+        uint64_t buf[3];
+        if (::read(fd, buf, sizeof(buf)) != sizeof(buf) || buf[2] == 0) {
+          continue;
+        }
+        s.counts[ev] += static_cast<uint64_t>(
+            static_cast<double>(buf[0]) * buf[1] / buf[2]);
+      }
+    }
+    return s;
+  }
+
+ private:
+  static void set_event(PerfEvent ev, perf_event_attr &attr) {
+    auto cache = [](uint64_t id) {
+      return id | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    };
+    switch (ev) {
+      case PERF_CYCLES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+      case PERF_INSTRUCTIONS:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+      case PERF_LLC_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = cache(PERF_COUNT_HW_CACHE_LL);
+        break;
+      case PERF_DTLB_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = cache(PERF_COUNT_HW_CACHE_DTLB);
+        break;
+      case PERF_BRANCH_MISSES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+      default:
+        break;
+    }
+  }
+
+  std::array<std::vector<int>, PERF_NUM_EVENTS> fds;
+  std::array<int, PERF_NUM_EVENTS> error{};
+  bool any_available = false;
+};
+
+// Accumulates wall time (and hardware counts when enabled) per named phase,
+// plus one record per MIS round. Call start() once, then lap()/lap_round()
+// at each phase boundary; everything since the previous mark is charged to
+// the given phase.
+class PhaseProfile {
+ public:
+  struct Round {
+    size_t frontier;
+    PerfSample sample;
+  };
+
+  explicit PhaseProfile(bool use_pmu = false) {
+    if (use_pmu) {
+      pmu = std::make_unique<PerfCounters>();
+      if (!pmu->available()) {
+        std::cerr << "Warning: hardware counters unavailable ("
+                  << std::strerror(pmu->open_error(PERF_CYCLES))
+                  << "), reporting wall time only" << std::endl;
+      }
+    }
+  }
+
+  void start() {
+    phases.clear();
+    round_log.clear();
+    last = snapshot();
+  }
+
+  void lap(const std::string &phase) { charge(phase, mark()); }
+
+  void lap_round(size_t frontier_size) {
+    PerfSample d = mark();
+    charge("frontier", d);
+    round_log.push_back({frontier_size, d});
+  }
+
+  size_t rounds() const { return round_log.size(); }
+  const std::vector<Round> &round_records() const { return round_log; }
+  const std::vector<std::pair<std::string, PerfSample>> &phase_records()
+      const {
+    return phases;
+  }
+  bool pmu_enabled() const { return pmu && pmu->available(); }
+
+  double seconds(const std::string &phase) const {
+    for (auto &[name, s] : phases) {
+      if (name == phase) return s.seconds;
+    }
+    return 0;
+  }
+
+  void report(std::ostream &os) const {
+    os << std::left << std::setw(14) << "phase" << std::right
+       << std::setw(12) << "time(s)";
+    if (pmu_enabled()) {
+      for (int ev = 0; ev < PERF_NUM_EVENTS; ev++) {
+        os << std::setw(16) << kPerfEventNames[ev];
+      }
+      os << std::setw(8) << "IPC";
+    }
+    os << "\n";
+    PerfSample total;
+    for (auto &[name, s] : phases) {
+      print_row(os, name, s);
+      total += s;
+    }
+    print_row(os, "total", total);
+    os << "rounds: " << rounds() << "\n";
+  }
+
+  // One CSV line per round: round, frontier size, seconds, then each event.
+  void write_rounds(const std::string &filename) const {
+    std::ofstream ofs(filename);
+    if (!ofs.is_open()) {
+      std::cerr << "Error: Cannot open output file " << filename << std::endl;
+      return;
+    }
+    ofs << "round,frontier,seconds";
+    for (int ev = 0; ev < PERF_NUM_EVENTS; ev++) {
+      ofs << "," << kPerfEventNames[ev];
+    }
+    ofs << "\n";
+    for (size_t r = 0; r < round_log.size(); r++) {
+      ofs << r + 1 << "," << round_log[r].frontier << ","
+          << round_log[r].sample.seconds;
+      for (int ev = 0; ev < PERF_NUM_EVENTS; ev++) {
+        ofs << ",";
+        if (pmu_enabled() && pmu->available(ev)) {
+          ofs << round_log[r].sample.counts[ev];
+        }
+      }
+      ofs << "\n";
+    }
+  }
+
+ private:
+  PerfSample snapshot() const {
+    if (pmu) return pmu->read();
+    PerfSample s;
+    s.seconds = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now().time_since_epoch())
+                    .count();
+    return s;
+  }
+
+  PerfSample mark() {
+    PerfSample now = snapshot();
+    PerfSample d = now - last;
+    last = now;
+    return d;
+  }
+
+  void charge(const std::string &phase, const PerfSample &d) {
+    for (auto &[name, s] : phases) {
+      if (name == phase) {
+        s += d;
+        return;
+      }
+    }
+    phases.emplace_back(phase, d);
+  }
+
+  void print_row(std::ostream &os, const std::string &name,
+                 const PerfSample &s) const {
+    os << std::left << std::setw(14) << name << std::right << std::setw(12)
+       << s.seconds;
+    if (pmu_enabled()) {
+      for (int ev = 0; ev < PERF_NUM_EVENTS; ev++) {
+        if (pmu->available(ev)) {
+          os << std::setw(16) << s.counts[ev];
+        } else {
+          os << std::setw(16) << "n/a";
+        }
+      }
+      if (pmu->available(PERF_CYCLES) && s.counts[PERF_CYCLES] != 0) {
+        os << std::setw(8) << std::setprecision(3)
+           << static_cast<double>(s.counts[PERF_INSTRUCTIONS]) /
+                  s.counts[PERF_CYCLES]
+           << std::setprecision(6);
+      } else {
+        os << std::setw(8) << "n/a";
+      }
+    }
+    os << "\n";
+  }
+
+  std::unique_ptr<PerfCounters> pmu;
+  PerfSample last;
+  std::vector<std::pair<std::string, PerfSample>> phases;
+  std::vector<Round> round_log;
+};
+
+#endif  // PERF_COUNTERS_H
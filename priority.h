@@ -0,0 +1,258 @@
+#ifndef PRIORITY_H
+#define PRIORITY_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+#include "parlay/utilities.h"
+#include "simd_count.h"
+
+// Where the MIS engines get a vertex's rank (smaller = earlier) from:
+//   perm        a stored random permutation, n entries, generated per seed
+//   hash        computed on demand from the vertex id and the seed, no array
+//   degree      stored; low-degree vertices tend to come first
+//   degeneracy  stored; vertices peeled early in a degeneracy order first
+// Chosen with MIS_PRIORITY (default perm). Taking low-degree vertices
+// first usually gives a larger independent set, but the rounds follow the
+// peeling structure and can be more (see par_mis --priority).
+//
+// The hash rank is a keyed permutation of [0, 2^bits) with 2^bits >= n: a
+// 4-round Feistel network over the two halves of the id. The round
+// function is a multiply-shift hash of the half xor a per-round key derived
+// from the seed, so a rank costs a few multiplies. Ranks are distinct
+// without a tie-break on the id, and the map can be inverted, so
+// sequential engines walk the ranks in order (skipping the at most
+// 2^bits - n ids >= n) instead of storing the order.
+enum PriorityKind {
+  PRIORITY_PERMUTATION,
+  PRIORITY_HASH,
+  PRIORITY_DEGREE,
+  PRIORITY_DEGENERACY
+};
+
+constexpr PriorityKind kPriorityKinds[] = {PRIORITY_PERMUTATION, PRIORITY_HASH,
+                                           PRIORITY_DEGREE,
+                                           PRIORITY_DEGENERACY};
+
+inline const char *priority_kind_name(PriorityKind kind) {
+  switch (kind) {
+    case PRIORITY_HASH:
+      return "hash";
+    case PRIORITY_DEGREE:
+      return "degree";
+    case PRIORITY_DEGENERACY:
+      return "degeneracy";
+    default:
+      return "perm";
+  }
+}
+
+inline PriorityKind priority_kind_from_env() {
+  const char *s = std::getenv("MIS_PRIORITY");
+  if (!s) return PRIORITY_PERMUTATION;
+  std::string v(s);
+  for (PriorityKind kind : kPriorityKinds) {
+    if (v == priority_kind_name(kind)) return kind;
+  }
+  std::cerr << "Warning: unknown MIS_PRIORITY=" << v << ", using perm"
+            << std::endl;
+  return PRIORITY_PERMUTATION;
+}
+
+class HashRank {
+ public:
+  HashRank(size_t n, uint64_t seed) {
+    size_t bits = 2;
+    while (bits < 64 && (uint64_t(1) << bits) < n) bits += 2;
+    half_ = bits / 2;
+    mask_ = (uint64_t(1) << half_) - 1;
+    for (uint64_t i = 0; i < kRounds; i++) {
+      keys_[i] = parlay::hash64(seed * kRounds + i + 1);
+    }
+  }
+
+  // Rank of vertex u.
+  uint64_t operator()(uint64_t u) const {
+    uint64_t l = u >> half_, r = u & mask_;
+    for (uint64_t i = 0; i < kRounds; i++) {
+      uint64_t t = l ^ round(r, i);
+      l = r;
+      r = t;
+    }
+    return (l << half_) | r;
+  }
+
+  // Vertex with rank x (may be >= n).
+  uint64_t vertex(uint64_t x) const {
+    uint64_t l = x >> half_, r = x & mask_;
+    for (uint64_t i = kRounds; i-- > 0;) {
+      uint64_t t = r ^ round(l, i);
+      r = l;
+      l = t;
+    }
+    return (l << half_) | r;
+  }
+
+  // Ranks are in [0, range()).
+  uint64_t range() const { return uint64_t(1) << (2 * half_); }
+
+ private:
+  static constexpr uint64_t kRounds = 4;
+
+  uint64_t round(uint64_t half, uint64_t i) const {
+    return ((half ^ keys_[i]) * 0x9e3779b97f4a7c15ull) >> (64 - half_);
+  }
+
+  uint64_t keys_[kRounds];
+  uint64_t half_ = 1;
+  uint64_t mask_ = 1;
+};
+
+// Stored ranks with the same call syntax as HashRank.
+template <class T>
+struct StoredRank {
+  const T *ranks;
+  T operator()(size_t u) const { return ranks[u]; }
+};
+
+// Peeling level of every vertex in an approximate degeneracy order (ADG,
+// Besta et al. SC'20): each step removes all remaining vertices whose
+// remaining degree is at most (1 + kDegeneracyEpsilon) times the average,
+// so there are O(log n) steps and a vertex's level is the step that
+// removed it. Levels order the vertices like smallest-last peeling, up to
+// a 2(1 + epsilon) factor in the degeneracy.
+constexpr double kDegeneracyEpsilon = 0.1;
+
+template <class Graph>
+parlay::sequence<uint32_t> degeneracy_levels(const Graph &G) {
+  using NodeId = typename Graph::NodeId;
+  size_t n = G.n;
+  parlay::sequence<uint32_t> level(n, UINT32_MAX);
+  parlay::sequence<std::atomic<int64_t>> deg(n);
+  parlay::parallel_for(0, n, [&](size_t u) {
+    deg[u].store(G.degree(static_cast<NodeId>(u)), std::memory_order_relaxed);
+  });
+  auto alive = parlay::tabulate(n, [](size_t u) { return static_cast<NodeId>(u); });
+  for (uint32_t step = 0; !alive.empty(); step++) {
+    int64_t total = parlay::reduce(parlay::delayed_seq<int64_t>(
+        alive.size(), [&](size_t i) { return deg[alive[i]].load(); }));
+    double threshold = (1 + kDegeneracyEpsilon) * total / alive.size();
+    auto peel = parlay::filter(alive, [&](NodeId u) {
+      return deg[u].load() <= threshold;
+    });
+    parlay::parallel_for(0, peel.size(), [&](size_t i) { level[peel[i]] = step; });
+    parlay::parallel_for(0, peel.size(), [&](size_t i) {
+      G.map_neighbors(peel[i], [&](NodeId v) {
+        if (level[v] == UINT32_MAX) deg[v].fetch_sub(1, std::memory_order_relaxed);
+      });
+    });
+    alive = parlay::filter(alive, [&](NodeId u) { return level[u] == UINT32_MAX; });
+  }
+  return level;
+}
+
+// Identifies the graph a cached, graph-dependent array (degree or
+// degeneracy ranks, matching incidence lists) was built for. The address
+// alone is not enough: a graph read into the same variable, or the next
+// graph of a loop in the same stack slot, keeps it. The key adds n, m, a
+// hash of the degrees of kGraphKeySamples evenly spaced vertices, and the
+// update count of graphs edited in place (DynamicGraph::version). A caller
+// that rewrites edges in place without changing any of these must drop the
+// cache itself.
+constexpr size_t kGraphKeySamples = 64;
+
+struct GraphKey {
+  const void *address = nullptr;
+  size_t n = 0, m = 0;
+  uint64_t degrees = 0;
+  size_t version = 0;
+
+  template <class Graph>
+  static GraphKey of(const Graph &G) {
+    using NodeId = typename Graph::NodeId;
+    GraphKey key{&G, G.n, G.m, 0, 0};
+    for (size_t i = 0; i < kGraphKeySamples && G.n; i++) {
+      NodeId u = static_cast<NodeId>(i * (G.n - 1) / (kGraphKeySamples - 1));
+      key.degrees = parlay::hash64(key.degrees ^ G.degree(u)) + i;
+    }
+    if constexpr (requires { G.version(); }) key.version = G.version();
+    return key;
+  }
+
+  bool operator==(const GraphKey &) const = default;
+};
+
+// Stored ranks for a non-hash kind: a permutation of [0, n) written to
+// ranks[0, n). degree and degeneracy quantise to a 32-bit primary key
+//   degree      2^32 - 2^32 * r / (1 + deg(u)), r uniform in (0, 1] from
+//               the seed (the 1/(1 + deg) scaling of app_mis1, inverted
+//               because smaller ranks go first)
+//   degeneracy  the ADG peeling level
+// and break ties by a 32-bit hash of (u, seed), then by id, so the ranks
+// are deterministic for a given graph and seed.
+template <class Graph, class T>
+void stored_ranks(const Graph &G, PriorityKind kind, uint64_t seed, T *ranks) {
+  using NodeId = typename Graph::NodeId;
+  size_t n = G.n;
+  if (kind != PRIORITY_DEGREE && kind != PRIORITY_DEGENERACY) {
+    auto perm = parlay::random_permutation<NodeId>(n, seed);
+    parlay::parallel_for(0, n, [&](size_t i) { ranks[i] = perm[i]; });
+    return;
+  }
+  auto tie = [&](size_t u) {
+    return parlay::hash32(static_cast<uint32_t>(parlay::hash64(u) ^ seed));
+  };
+  parlay::sequence<uint64_t> key;
+  if (kind == PRIORITY_DEGREE) {
+    key = parlay::tabulate(n, [&](size_t u) {
+      double r = (tie(u) + 1.0) / 4294967296.0;
+      double x = r / (1.0 + G.degree(static_cast<NodeId>(u)));
+      uint64_t q = static_cast<uint64_t>(x * 4294967295.0);
+      return ((uint64_t(UINT32_MAX) - q) << 32) | tie(u);
+    });
+  } else {
+    auto level = degeneracy_levels(G);
+    key = parlay::tabulate(n, [&](size_t u) {
+      return (uint64_t(level[u]) << 32) | tie(u);
+    });
+  }
+  auto order = parlay::sort(parlay::iota<NodeId>(n), [&](NodeId a, NodeId b) {
+    return key[a] != key[b] ? key[a] < key[b] : a < b;
+  });
+  parlay::parallel_for(0, n, [&](size_t i) { ranks[order[i]] = static_cast<T>(i); });
+}
+
+// Number of neighbors of u with a smaller rank. Stored ranks go through
+// the gather kernels of simd_count.h; computed ranks are evaluated per
+// neighbor (edge-parallel for high-degree vertices of CSR graphs).
+template <class Graph, class T>
+size_t count_neighbors_before(const Graph &G, StoredRank<T> rank,
+                              typename Graph::NodeId u) {
+  return count_neighbors_before(G, rank.ranks, u);
+}
+
+template <class Graph>
+size_t count_neighbors_before(const Graph &G, const HashRank &rank,
+                              typename Graph::NodeId u) {
+  using NodeId = typename Graph::NodeId;
+  const uint64_t key = rank(u);
+  if constexpr (requires { G.edges[0].v; G.offsets[0]; }) {
+    size_t lo = G.offsets[u], deg = G.offsets[u + 1] - lo;
+    if (deg > kEdgeParallelDegree) {
+      return parlay::reduce(parlay::delayed_seq<size_t>(deg, [&](size_t i) {
+        return rank(G.edges[lo + i].v) < key;
+      }));
+    }
+  }
+  size_t count = 0;
+  G.map_neighbors(u, [&](NodeId v) { count += rank(v) < key; });
+  return count;
+}
+
+#endif  // PRIORITY_H
@@ -0,0 +1,341 @@
+#ifndef REORDER_H
+#define REORDER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "graph.h"
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+#include "priority.h"
+
+// Vertex reorderings for cache locality. The MIS engines gather
+// status/priority/counter by neighbor id, so a labeling that puts neighbors
+// at nearby ids turns those gathers into mostly-cached reads. Every method
+// returns an order: order[i] is the old id of the vertex that gets new id i.
+//   degree  degree-descending (hubs share the first cache lines)
+//   rcm     reverse Cuthill-McKee: BFS from a minimum-degree vertex of each
+//           component, children by increasing degree, whole order reversed
+//   bfs     BFS from the lowest unvisited id of each component
+//   gorder  Gorder-style greedy window over blocks of the BFS order
+//   random  the vertex ranked i by the perm priority of a seed (priority.h)
+//           gets id i, so a sequential pass in id order on the relabeled
+//           graph is the MIS par_mis computes with that seed (perm)
+// The BFS levels are expanded in parallel and deterministically (a vertex
+// goes to the earliest frontier vertex that reaches it). Isolated vertices
+// are placed after everything else by all methods but degree and
+// random.
+enum ReorderMethod {
+  REORDER_DEGREE,
+  REORDER_RCM,
+  REORDER_BFS,
+  REORDER_GORDER,
+  REORDER_RANDOM
+};
+
+constexpr ReorderMethod kReorderMethods[] = {REORDER_DEGREE, REORDER_RCM,
+                                             REORDER_BFS, REORDER_GORDER,
+                                             REORDER_RANDOM};
+
+inline const char *reorder_method_name(ReorderMethod method) {
+  switch (method) {
+    case REORDER_DEGREE:
+      return "degree";
+    case REORDER_RCM:
+      return "rcm";
+    case REORDER_BFS:
+      return "bfs";
+    case REORDER_GORDER:
+      return "gorder";
+    default:
+      return "random";
+  }
+}
+
+// Returns false if name is not one of the methods above.
+inline bool parse_reorder_method(const std::string &name,
+                                 ReorderMethod &method) {
+  for (ReorderMethod m : kReorderMethods) {
+    if (name == reorder_method_name(m)) {
+      method = m;
+      return true;
+    }
+  }
+  return false;
+}
+
+template <class Graph>
+parlay::sequence<typename Graph::NodeId> degree_order(const Graph &G) {
+  using NodeId = typename Graph::NodeId;
+  return parlay::sort(parlay::iota<NodeId>(G.n), [&](NodeId a, NodeId b) {
+    size_t da = G.degree(a), db = G.degree(b);
+    return da != db ? da > db : a < b;
+  });
+}
+
+// BFS over every component. Roots are taken from starts (skipping visited
+// vertices); starts should hold every non-isolated vertex once. With
+// by_degree, the children of each vertex are emitted by increasing degree.
+template <class Graph>
+parlay::sequence<typename Graph::NodeId> bfs_order(
+    const Graph &G, const parlay::sequence<typename Graph::NodeId> &starts,
+    bool by_degree) {
+  using NodeId = typename Graph::NodeId;
+  constexpr NodeId kUnclaimed = std::numeric_limits<NodeId>::max();
+  size_t n = G.n;
+  parlay::sequence<NodeId> claim(n, kUnclaimed);
+  parlay::sequence<uint8_t> visited(n, 0);
+  auto order = parlay::sequence<NodeId>::uninitialized(n);
+  size_t len = 0, next_start = 0;
+  while (true) {
+    while (next_start < starts.size() && visited[starts[next_start]]) {
+      next_start++;
+    }
+    if (next_start == starts.size()) break;
+    NodeId root = starts[next_start];
+    visited[root] = 1;
+    parlay::sequence<NodeId> frontier(1, root);
+    while (!frontier.empty()) {
+      std::copy(frontier.begin(), frontier.end(), order.begin() + len);
+      len += frontier.size();
+      // Each unvisited neighbor goes to the first frontier vertex reaching it.
+      parlay::parallel_for(0, frontier.size(), [&](size_t i) {
+        G.map_neighbors(frontier[i], [&](NodeId v) {
+          if (!visited[v]) write_min(&claim[v], static_cast<NodeId>(i));
+        });
+      });
+      auto children = parlay::tabulate(frontier.size(), [&](size_t i) {
+        parlay::sequence<NodeId> kids;
+        G.map_neighbors(frontier[i], [&](NodeId v) {
+          if (!visited[v] && claim[v] == i) {
+            visited[v] = 1;  // only this i can claim v
+            kids.push_back(v);
+          }
+        });
+        if (by_degree) {
+          std::sort(kids.begin(), kids.end(), [&](NodeId a, NodeId b) {
+            size_t da = G.degree(a), db = G.degree(b);
+            return da != db ? da < db : a < b;
+          });
+        }
+        return kids;
+      });
+      frontier = parlay::flatten(children);
+    }
+  }
+  // Isolated vertices (and anything starts left out) go last, in id order.
+  auto rest = parlay::filter(parlay::iota<NodeId>(n),
+                             [&](NodeId u) { return !visited[u]; });
+  std::copy(rest.begin(), rest.end(), order.begin() + len);
+  return order;
+}
+
+template <class Graph>
+parlay::sequence<typename Graph::NodeId> bfs_order(const Graph &G) {
+  using NodeId = typename Graph::NodeId;
+  auto starts = parlay::filter(parlay::iota<NodeId>(G.n),
+                               [&](NodeId u) { return G.degree(u) > 0; });
+  return bfs_order(G, starts, false);
+}
+
+template <class Graph>
+parlay::sequence<typename Graph::NodeId> rcm_order(const Graph &G) {
+  using NodeId = typename Graph::NodeId;
+  auto starts = parlay::filter(parlay::iota<NodeId>(G.n),
+                               [&](NodeId u) { return G.degree(u) > 0; });
+  starts = parlay::sort(starts, [&](NodeId a, NodeId b) {
+    size_t da = G.degree(a), db = G.degree(b);
+    return da != db ? da < db : a < b;
+  });
+  return parlay::reverse(bfs_order(G, starts, true));
+}
+
+// Gorder-lite. Gorder places next the vertex with the most neighbors and
+// shared neighbors among the last kGorderWindow placed vertices. Here the
+// greedy runs independently (and in parallel) on blocks of kGorderBlock
+// consecutive vertices of the BFS order, only choosing among the block's
+// vertices; shared neighbors through hubs (degree > kGorderHubDegree) are
+// not counted. As in Gorder, scores sit in a unit heap (one list per score
+// value), so a +1/-1 is O(1). When no candidate has a positive score, the
+// next vertex in BFS order is taken.
+constexpr size_t kGorderWindow = 5;
+constexpr size_t kGorderBlock = size_t(1) << 16;
+constexpr size_t kGorderHubDegree = 64;
+
+template <class Graph>
+parlay::sequence<typename Graph::NodeId> gorder_order(const Graph &G) {
+  using NodeId = typename Graph::NodeId;
+  constexpr uint32_t kNone = UINT32_MAX;
+  size_t n = G.n;
+  auto base = bfs_order(G);
+  auto pos = parlay::sequence<NodeId>::uninitialized(n);
+  parlay::parallel_for(0, n, [&](size_t i) { pos[base[i]] = i; });
+  auto order = parlay::sequence<NodeId>::uninitialized(n);
+  size_t blocks = (n + kGorderBlock - 1) / kGorderBlock;
+  parlay::parallel_for(0, blocks, [&](size_t b) {
+    size_t lo = b * kGorderBlock, hi = std::min(n, lo + kGorderBlock);
+    size_t size = hi - lo;
+    // Local index x = BFS position - lo. Vertices with score 0 are in no list.
+    std::vector<uint32_t> score(size, 0), prev(size), next(size);
+    std::vector<uint32_t> head(1, kNone);
+    std::vector<uint8_t> placed(size, 0);
+    size_t top = 0;
+    auto link = [&](uint32_t x) {
+      uint32_t s = score[x];
+      if (s == 0) return;
+      if (head.size() <= s) head.resize(2 * s, kNone);
+      prev[x] = kNone;
+      next[x] = head[s];
+      if (head[s] != kNone) prev[head[s]] = x;
+      head[s] = x;
+      top = std::max<size_t>(top, s);
+    };
+    auto unlink = [&](uint32_t x) {
+      uint32_t s = score[x];
+      if (s == 0) return;
+      if (prev[x] != kNone) next[prev[x]] = next[x];
+      else head[s] = next[x];
+      if (next[x] != kNone) prev[next[x]] = prev[x];
+    };
+    auto bump = [&](NodeId v, int delta) {
+      size_t p = pos[v];
+      if (p < lo || p >= hi || placed[p - lo]) return;
+      uint32_t x = p - lo;
+      unlink(x);
+      score[x] += delta;
+      link(x);
+    };
+    // Adds (delta = 1) or removes (-1) u's contribution to the window.
+    auto update = [&](NodeId u, int delta) {
+      G.map_neighbors(u, [&](NodeId x) {
+        bump(x, delta);
+        if (G.degree(x) > kGorderHubDegree) return;
+        G.map_neighbors(x, [&](NodeId y) {
+          if (y != u) bump(y, delta);
+        });
+      });
+    };
+    std::vector<NodeId> window;
+    size_t next_seed = 0;
+    for (size_t out = lo; out < hi; out++) {
+      while (top > 0 && head[top] == kNone) top--;
+      uint32_t x;
+      if (top > 0) {
+        x = head[top];
+      } else {
+        while (placed[next_seed]) next_seed++;
+        x = next_seed;
+      }
+      unlink(x);
+      placed[x] = 1;
+      NodeId u = base[lo + x];
+      order[out] = u;
+      update(u, 1);
+      window.push_back(u);
+      if (window.size() > kGorderWindow) {
+        update(window.front(), -1);
+        window.erase(window.begin());
+      }
+    }
+  }, 1);
+  return order;
+}
+
+template <class Graph>
+parlay::sequence<typename Graph::NodeId> random_order(const Graph &G,
+                                                      uint64_t seed) {
+  using NodeId = typename Graph::NodeId;
+  auto rank = parlay::sequence<NodeId>::uninitialized(G.n);
+  stored_ranks(G, PRIORITY_PERMUTATION, seed, rank.begin());
+  auto order = parlay::sequence<NodeId>::uninitialized(G.n);
+  parlay::parallel_for(0, G.n, [&](size_t u) { order[rank[u]] = u; });
+  return order;
+}
+
+// seed is only used by random.
+template <class Graph>
+parlay::sequence<typename Graph::NodeId> reorder(const Graph &G,
+                                                 ReorderMethod method,
+                                                 uint64_t seed = 0) {
+  switch (method) {
+    case REORDER_DEGREE:
+      return degree_order(G);
+    case REORDER_RCM:
+      return rcm_order(G);
+    case REORDER_BFS:
+      return bfs_order(G);
+    case REORDER_GORDER:
+      return gorder_order(G);
+    default:
+      return random_order(G, seed);
+  }
+}
+
+// Neighbor lists longer than this are sorted with the parallel sort.
+constexpr size_t kParallelSortDegree = size_t(1) << 14;
+
+// new_id[order[i]] = i.
+template <class NodeId>
+parlay::sequence<NodeId> order_to_permutation(
+    const parlay::sequence<NodeId> &order) {
+  auto new_id = parlay::sequence<NodeId>::uninitialized(order.size());
+  parlay::parallel_for(0, order.size(),
+                       [&](size_t i) { new_id[order[i]] = i; });
+  return new_id;
+}
+
+// The graph with vertex order[i] renamed to i. Neighbor lists are sorted
+// by new id; edge weights follow their edges. Out-edges only: symmetrize
+// directed graphs first.
+template <class Graph>
+Graph relabel(const Graph &G, const parlay::sequence<typename Graph::NodeId> &order) {
+  using NodeId = typename Graph::NodeId;
+  using EdgeId = typename Graph::EdgeId;
+  using Edge = typename Graph::Edge;
+  auto new_id = order_to_permutation(order);
+  Graph H;
+  H.n = G.n;
+  H.m = G.m;
+  H.symmetrized = G.symmetrized;
+  H.weighted = G.weighted;
+  H.offsets = parlay::sequence<EdgeId>(G.n + 1, 0);
+  parlay::parallel_for(0, G.n, [&](size_t i) { H.offsets[i] = G.degree(order[i]); });
+  parlay::scan_inplace(H.offsets);
+  H.edges = parlay::sequence<Edge>::uninitialized(G.m);
+  parlay::parallel_for(0, G.n, [&](size_t i) {
+    NodeId u = order[i];
+    EdgeId out = H.offsets[i];
+    for (EdgeId e = G.offsets[u]; e < G.offsets[u + 1]; e++) {
+      H.edges[out++] = Edge(new_id[G.edges[e].v], G.edges[e].w);
+    }
+    auto list = H.edges.cut(H.offsets[i], H.offsets[i + 1]);
+    if (list.size() > kParallelSortDegree) {
+      parlay::sort_inplace(list);
+    } else {
+      std::sort(list.begin(), list.end());
+    }
+  });
+  return H;
+}
+
+// Mean of log2(|u - v| + 1) over all edges: a cheap locality score (lower
+// is better) to compare orders with.
+template <class Graph>
+double edge_log_gap(const Graph &G) {
+  using NodeId = typename Graph::NodeId;
+  if (G.m == 0) return 0;
+  auto gaps = parlay::delayed_seq<double>(G.n, [&](size_t u) {
+    double sum = 0;
+    G.map_neighbors(static_cast<NodeId>(u), [&](NodeId v) {
+      sum += std::log2(1.0 + std::abs(static_cast<double>(u) - v));
+    });
+    return sum;
+  });
+  return parlay::reduce(gaps) / G.m;
+}
+
+#endif  // REORDER_H
@@ -1,5 +1,6 @@
 #include "utils/utils.h"
 #include "utils/graph.h"
+#include "implicit_graph.h"
 #include <algorithm>
 #include <cstdlib>
 #include <fstream>
@@ -8,43 +9,9 @@
 #include <unordered_set>
 #include <vector>
 #include <filesystem>
+#include "mis.h"
 using namespace parlay;
 
-template <class Graph>
-std::vector<typename Graph::NodeId> MIS(const Graph &G, bool use_permutation = true) {
-    using NodeId = typename Graph::NodeId;
-    size_t n = G.n;
-
-    // Create a permutation to randomize vertex processing order (like GBBS)
-    auto perm = use_permutation ? parlay::random_permutation<NodeId>(n)
-                                 : parlay::sequence<NodeId>::from_function(n, [](size_t i) { return i; });
-
-    std::vector<bool> in_MIS(n, false);
-    std::vector<bool> removed(n, false);
-
-    // in default permuted order
-    for (size_t i = 0; i < n; i++) {
-        NodeId u = perm[i];
-        if (!removed[u]) {
-            // Add this vertex 
-            in_MIS[u] = true;
-            removed[u] = true;
-            // Mark neighbors as removed
-            for (size_t e = G.offsets[u]; e < G.offsets[u + 1]; e++) {
-                NodeId v = G.edges[e].v;
-                removed[v] = true;
-            }
-        }
-    }
-
-
-    std::vector<NodeId> result;
-    for (NodeId u = 0; u < n; u++) {
-        if (in_MIS[u]) result.push_back(u);
-    }
-    return result;
-}
-
 template <class NodeId>
 void save_mis_to_file(const std::vector<NodeId>& mis_set, const std::string& filename) {
     auto sorted_mis = mis_set;
@@ -71,21 +38,16 @@ void save_mis_to_file(const std::vector<NodeId>& mis_set, const std::string& fil
     // std::cout << "MIS result saved to " << filename << std::endl;
 }
 
-int main(int argc, char* argv[]) {
-    if (argc < 2 || argc > 3) { std::cerr << "Usage: ./mis input_graph [verify]" << std::endl; return 1; }
-    const char* filename = argv[1];
-    Graph<uint32_t, uint64_t> G;
-    G.read_graph(filename);
-    if (!G.symmetrized) { G = make_symmetrized(G); }
+template <class Graph>
+int run(const Graph& G, const std::string& graphname, int argc, char* argv[]) {
     // Warm up
-    { auto tmp = MIS(G); }
+    { auto tmp = SeqMIS(G); }
     // Test
-    std::string graphname = std::filesystem::path(filename).stem().string();
     std::vector<double> times;
     std::cout << graphname << "    ";
     for (int run = 1; run <= 3; run++) {
         internal::timer t;
-        auto mis_set = MIS(G);
+        auto mis_set = SeqMIS(G);
         t.stop();
         times.push_back(t.total_time());
     }
@@ -95,12 +57,34 @@ int main(int argc, char* argv[]) {
     bool verify = false;
     if (argc == 3) verify = (std::atoi(argv[2]) != 0);
     if (verify) {
-        auto mis_set = MIS(G);
+        auto mis_set = SeqMIS(G);
         std::string output_file = "./results/" + graphname + ".txt";
         save_mis_to_file(mis_set, output_file);
     }
     return 0;
 }
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: ./mis input_graph [verify]\n"
+                  << "input_graph: a .bin/.adj file, or grid:<rows>x<cols> | torus:<rows>x<cols> | circulant:<n>:<s1>,<s2>,..."
+                  << std::endl;
+        return 1;
+    }
+    const char* filename = argv[1];
+    // Implicit graphs generate neighbors on the fly; no CSR is built
+    int ret = 0;
+    std::string implicit_name = filename;
+    std::replace(implicit_name.begin(), implicit_name.end(), ':', '_');
+    std::replace(implicit_name.begin(), implicit_name.end(), ',', '_');
+    if (with_implicit_graph(filename, [&](const auto& G) { ret = run(G, implicit_name, argc, argv); })) {
+        return ret;
+    }
+    Graph<uint32_t, uint64_t> G;
+    G.read_graph(filename);
+    if (!G.symmetrized) { G = make_symmetrized(G); }
+    return run(G, std::filesystem::path(filename).stem().string(), argc, argv);
+}
 /*
     auto mis_flags = parlay::sequence<bool>(G.n, false);
     parlay::parallel_for(0, mis_set.size(), [&](size_t i) {
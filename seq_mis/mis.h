@@ -0,0 +1,65 @@
+#pragma once
+#include <vector>
+
+#include "parlay/primitives.h"
+#include "parlay/random.h"
+#include "perf_counters.h"
+#include "priority.h"
+
+// Sequential greedy MIS in a random vertex order (seed selects the order).
+// With PRIORITY_HASH the order is the hash rank of priority.h, walked by
+// inverting it instead of storing a permutation; with PRIORITY_DEGREE and
+// PRIORITY_DEGENERACY it is the order of stored_ranks. In these three
+// cases par_mis with the same MIS_PRIORITY and seed returns the same set.
+template <class Graph>
+std::vector<typename Graph::NodeId> SeqMIS(const Graph &G, bool use_permutation = true,
+                                           size_t seed = 0, PhaseProfile *prof = nullptr,
+                                           PriorityKind kind = priority_kind_from_env()) {
+    using NodeId = typename Graph::NodeId;
+    size_t n = G.n;
+    if (prof) prof->start();
+
+    std::vector<bool> in_MIS(n, false);
+    std::vector<bool> removed(n, false);
+    auto visit = [&](NodeId u) {
+        if (!removed[u]) {
+            // Add this vertex 
+            in_MIS[u] = true;
+            removed[u] = true;
+            // Mark neighbors as removed
+            G.map_neighbors(u, [&](NodeId v) { removed[v] = true; });
+        }
+    };
+
+    if (use_permutation && kind == PRIORITY_HASH) {
+        HashRank rank(n, seed);
+        if (prof) prof->lap("init");
+        for (uint64_t x = 0; x < rank.range(); x++) {
+            uint64_t u = rank.vertex(x);
+            if (u < n) visit(static_cast<NodeId>(u));
+        }
+    } else if (use_permutation && (kind == PRIORITY_DEGREE || kind == PRIORITY_DEGENERACY)) {
+        auto ranks = parlay::sequence<NodeId>::uninitialized(n);
+        stored_ranks(G, kind, seed, ranks.begin());
+        auto order = parlay::sequence<NodeId>::uninitialized(n);
+        parlay::parallel_for(0, n, [&](size_t u) { order[ranks[u]] = u; });
+        if (prof) prof->lap("init");
+        for (size_t i = 0; i < n; i++) visit(order[i]);
+    } else {
+        // Create a permutation to randomize vertex processing order (like GBBS)
+        auto perm = use_permutation ? parlay::random_permutation<NodeId>(n, seed)
+                                     : parlay::sequence<NodeId>::from_function(n, [](size_t i) { return i; });
+        if (prof) prof->lap("init");
+
+        // in default permuted order
+        for (size_t i = 0; i < n; i++) visit(perm[i]);
+    }
+    if (prof) prof->lap("greedy");
+
+    std::vector<NodeId> result;
+    for (NodeId u = 0; u < n; u++) {
+        if (in_MIS[u]) result.push_back(u);
+    }
+    if (prof) prof->lap("extract");
+    return result;
+}
@@ -5,78 +5,10 @@
 #include <fstream>
 #include <iostream>
 #include <numeric>
+#include "mis_dag.h"
 // #include <vector>
 using namespace parlay;
 
-template <class Graph>
-parlay::sequence<typename Graph::NodeId> MIS_DAG(const Graph &G) {
-    using NodeId = typename Graph::NodeId;
-    size_t n = G.n;
-
-    auto perm = parlay::random_permutation<NodeId>(n);
-
-    parlay::sequence<int> priorities(n);
-    for (NodeId u = 0; u < n; u++) {
-        int count = 0;
-        for (size_t e = G.offsets[u]; e < G.offsets[u+1]; e++) {
-            NodeId v = G.edges[e].v;
-            if (perm[v] < perm[u]) count++;
-        }
-        priorities[u] = count;
-    }
-
-    parlay::sequence<bool> in_mis(n, false);
-    parlay::sequence<bool> excluded(n, false);
-    size_t finished = 0;
-
-    while (finished < n) {
-        parlay::sequence<NodeId> roots;
-        for (NodeId u = 0; u < n; u++) {
-            if (priorities[u] == 0 && !in_mis[u] && !excluded[u]) {
-                roots.push_back(u);
-            }
-        }
-
-        if (roots.empty()) break;
-
-        for (NodeId u : roots) {
-            in_mis[u] = true;
-        }
-
-        parlay::sequence<bool> removed_mark(n, false);
-        parlay::sequence<NodeId> removed;
-        for (NodeId u : roots) {
-            for (size_t e = G.offsets[u]; e < G.offsets[u+1]; e++) {
-                NodeId v = G.edges[e].v;
-                if (priorities[v] > 0 && !removed_mark[v]) {
-                    removed.push_back(v);
-                    removed_mark[v] = true;
-                    excluded[v] = true;
-                    priorities[v] = 0;
-                }
-            }
-        }
-
-        for (NodeId u : removed) {
-            for (size_t e = G.offsets[u]; e < G.offsets[u+1]; e++) {
-                NodeId v = G.edges[e].v;
-                if (priorities[v] > 0 && perm[u] < perm[v]) {
-                    priorities[v]--;
-                }
-            }
-        }
-
-        finished += roots.size();
-        finished += removed.size();
-    }
-
-    parlay::sequence<NodeId> result;
-    for (NodeId u = 0; u < n; u++) {
-        if (in_mis[u]) result.push_back(u);
-    }
-    return result;
-}
-
 template <class NodeId>
 void save_mis_to_file(const parlay::sequence<NodeId>& mis_set, const std::string& filename) {
     auto sorted_mis = parlay::sort(mis_set);
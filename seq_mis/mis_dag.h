@@ -0,0 +1,73 @@
+#pragma once
+#include "parlay/primitives.h"
+#include "parlay/random.h"
+#include "perf_counters.h"
+#include "simd_count.h"
+
+// Round-by-round (DAG level) MIS, run serially; seed selects the priorities.
+template <class Graph>
+parlay::sequence<typename Graph::NodeId> MIS_DAG(const Graph &G, size_t seed = 0, PhaseProfile *prof = nullptr) {
+    using NodeId = typename Graph::NodeId;
+    size_t n = G.n;
+    if (prof) prof->start();
+
+    auto perm = parlay::random_permutation<NodeId>(n, seed);
+
+    parlay::sequence<int> priorities(n);
+    // Count with the gather kernels (simd_count.h), still one vertex at a time.
+    for (NodeId u = 0; u < n; u++) {
+        priorities[u] = count_neighbors_before(G, perm.begin(), u, false);
+    }
+
+    parlay::sequence<bool> in_mis(n, false);
+    parlay::sequence<bool> excluded(n, false);
+    size_t finished = 0;
+    if (prof) prof->lap("counter_init");
+
+    while (finished < n) {
+        parlay::sequence<NodeId> roots;
+        for (NodeId u = 0; u < n; u++) {
+            if (priorities[u] == 0 && !in_mis[u] && !excluded[u]) {
+                roots.push_back(u);
+            }
+        }
+
+        if (roots.empty()) break;
+
+        for (NodeId u : roots) {
+            in_mis[u] = true;
+        }
+
+        parlay::sequence<bool> removed_mark(n, false);
+        parlay::sequence<NodeId> removed;
+        for (NodeId u : roots) {
+            G.map_neighbors(u, [&](NodeId v) {
+                if (priorities[v] > 0 && !removed_mark[v]) {
+                    removed.push_back(v);
+                    removed_mark[v] = true;
+                    excluded[v] = true;
+                    priorities[v] = 0;
+                }
+            });
+        }
+
+        for (NodeId u : removed) {
+            G.map_neighbors(u, [&](NodeId v) {
+                if (priorities[v] > 0 && perm[u] < perm[v]) {
+                    priorities[v]--;
+                }
+            });
+        }
+
+        finished += roots.size();
+        finished += removed.size();
+        if (prof) prof->lap_round(roots.size());
+    }
+
+    parlay::sequence<NodeId> result;
+    for (NodeId u = 0; u < n; u++) {
+        if (in_mis[u]) result.push_back(u);
+    }
+    if (prof) prof->lap("extract");
+    return result;
+}
@@ -0,0 +1,216 @@
+#ifndef SIMD_COUNT_H
+#define SIMD_COUNT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_COUNT_X86 1
+#endif
+
+// Vectorized "how many neighbors come before u" for the counter
+// initialization pass: gather keys[v] for a run of neighbor ids and compare
+// against keys[u] eight (AVX2) or sixteen (AVX-512) at a time. The kernel is
+// chosen once at runtime from the CPU, and can be forced with
+//   MIS_SIMD = scalar | avx2 | avx512
+// (clamped to what the CPU supports). Gathers take 32-bit signed indices, so
+// graphs with n > 2^31 and non-CSR graphs use the scalar loop.
+enum SimdLevel { SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512 };
+
+inline const char *simd_level_name(SimdLevel level) {
+  switch (level) {
+    case SIMD_AVX2:
+      return "avx2";
+    case SIMD_AVX512:
+      return "avx512";
+    default:
+      return "scalar";
+  }
+}
+
+inline SimdLevel detect_simd_level() {
+#ifdef SIMD_COUNT_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return SIMD_AVX512;
+  if (__builtin_cpu_supports("avx2")) return SIMD_AVX2;
+#endif
+  return SIMD_SCALAR;
+}
+
+// Level used by count_neighbors_before; set_simd_level overrides it (e.g.
+// to benchmark the kernels against each other).
+inline SimdLevel &simd_level_slot() {
+  static SimdLevel level = [] {
+    SimdLevel best = detect_simd_level();
+    const char *s = std::getenv("MIS_SIMD");
+    if (!s) return best;
+    std::string v(s);
+    SimdLevel want = v == "avx512" ? SIMD_AVX512
+                     : v == "avx2" ? SIMD_AVX2
+                                   : SIMD_SCALAR;
+    if (v != "scalar" && v != "avx2" && v != "avx512") {
+      std::cerr << "Warning: unknown MIS_SIMD=" << v << ", using scalar"
+                << std::endl;
+    }
+    return want < best ? want : best;
+  }();
+  return level;
+}
+
+inline SimdLevel simd_level() { return simd_level_slot(); }
+
+inline void set_simd_level(SimdLevel level) {
+  SimdLevel best = detect_simd_level();
+  simd_level_slot() = level < best ? level : best;
+}
+
+// Number of i in [0, len) with keys[idx[i]] < key (or > key if kGreater).
+template <bool kGreater, class T>
+size_t count_gathered_scalar(const T *keys, const uint32_t *idx, size_t len,
+                             T key) {
+  size_t count = 0;
+  for (size_t i = 0; i < len; i++) {
+    count += kGreater ? keys[idx[i]] > key : keys[idx[i]] < key;
+  }
+  return count;
+}
+
+#ifdef SIMD_COUNT_X86
+template <bool kGreater>
+__attribute__((target("avx2"))) size_t count_gathered_avx2(
+    const uint32_t *keys, const uint32_t *idx, size_t len, uint32_t key) {
+  // No unsigned compare in AVX2: flip the sign bit on both sides. Gathers
+  // below use the masked form with a defined source (GCC warns otherwise).
+  const __m256i bias = _mm256_set1_epi32(INT32_MIN);
+  const __m256i all = _mm256_set1_epi32(-1);
+  const __m256i k = _mm256_xor_si256(_mm256_set1_epi32(key), bias);
+  const int *base = reinterpret_cast<const int *>(keys);
+  size_t count = 0, i = 0;
+  for (; i + 8 <= len; i += 8) {
+    __m256i vi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(idx + i));
+    __m256i g = _mm256_xor_si256(_mm256_mask_i32gather_epi32(all, base, vi, all, 4), bias);
+    __m256i lt = kGreater ? _mm256_cmpgt_epi32(g, k) : _mm256_cmpgt_epi32(k, g);
+    count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(lt)));
+  }
+  return count + count_gathered_scalar<kGreater>(keys, idx + i, len - i, key);
+}
+
+template <bool kGreater>
+__attribute__((target("avx2"))) size_t count_gathered_avx2(
+    const double *keys, const uint32_t *idx, size_t len, double key) {
+  const __m256d k = _mm256_set1_pd(key);
+  const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+  size_t count = 0, i = 0;
+  for (; i + 4 <= len; i += 4) {
+    __m128i vi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(idx + i));
+    __m256d g = _mm256_mask_i32gather_pd(k, keys, vi, all, 8);
+    __m256d c = kGreater ? _mm256_cmp_pd(g, k, _CMP_GT_OQ)
+                         : _mm256_cmp_pd(g, k, _CMP_LT_OQ);
+    count += __builtin_popcount(_mm256_movemask_pd(c));
+  }
+  return count + count_gathered_scalar<kGreater>(keys, idx + i, len - i, key);
+}
+
+template <bool kGreater>
+__attribute__((target("avx512f"))) size_t count_gathered_avx512(
+    const uint32_t *keys, const uint32_t *idx, size_t len, uint32_t key) {
+  const __m512i k = _mm512_set1_epi32(key);
+  size_t count = 0, i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m512i vi = _mm512_loadu_si512(idx + i);
+    __m512i g = _mm512_mask_i32gather_epi32(k, 0xFFFF, vi, keys, 4);
+    __mmask16 c = kGreater ? _mm512_cmpgt_epu32_mask(g, k)
+                           : _mm512_cmplt_epu32_mask(g, k);
+    count += __builtin_popcount(c);
+  }
+  if (i < len) {
+    __mmask16 tail = static_cast<__mmask16>((1u << (len - i)) - 1);
+    __m512i vi = _mm512_maskz_loadu_epi32(tail, idx + i);
+    __m512i g = _mm512_mask_i32gather_epi32(k, tail, vi, keys, 4);
+    __mmask16 c = kGreater ? _mm512_mask_cmpgt_epu32_mask(tail, g, k)
+                           : _mm512_mask_cmplt_epu32_mask(tail, g, k);
+    count += __builtin_popcount(c);
+  }
+  return count;
+}
+
+template <bool kGreater>
+__attribute__((target("avx512f"))) size_t count_gathered_avx512(
+    const double *keys, const uint32_t *idx, size_t len, double key) {
+  const __m512d k = _mm512_set1_pd(key);
+  const int cmp = kGreater ? _CMP_GT_OQ : _CMP_LT_OQ;
+  size_t count = 0, i = 0;
+  for (; i + 8 <= len; i += 8) {
+    __m256i vi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(idx + i));
+    __m512d g = _mm512_mask_i32gather_pd(k, 0xFF, vi, keys, 8);
+    count += __builtin_popcount(_mm512_cmp_pd_mask(g, k, cmp));
+  }
+  return count + count_gathered_scalar<kGreater>(keys, idx + i, len - i, key);
+}
+#endif
+
+template <bool kGreater, class T>
+size_t count_gathered(const T *keys, const uint32_t *idx, size_t len, T key,
+                      SimdLevel level) {
+#ifdef SIMD_COUNT_X86
+  if constexpr (std::is_same_v<T, uint32_t> || std::is_same_v<T, double>) {
+    if (level == SIMD_AVX512) {
+      return count_gathered_avx512<kGreater>(keys, idx, len, key);
+    }
+    if (level == SIMD_AVX2) {
+      return count_gathered_avx2<kGreater>(keys, idx, len, key);
+    }
+  }
+#endif
+  return count_gathered_scalar<kGreater>(keys, idx, len, key);
+}
+
+// Vertices with more neighbors than this are counted edge-parallel, in
+// blocks of kCountBlock edges.
+constexpr size_t kEdgeParallelDegree = size_t(1) << 15;
+constexpr size_t kCountBlock = size_t(1) << 12;
+
+// Number of neighbors v of u with keys[v] < keys[u] (or > if kGreater).
+// keys is indexed by vertex id. CSR graphs (Graph, GraphView) go through
+// the gather kernels, other graphs through map_neighbors. With edge_parallel,
+// high-degree vertices split their neighbor list across workers.
+template <bool kGreater = false, class Graph, class T>
+size_t count_neighbors_before(const Graph &G, const T *keys,
+                              typename Graph::NodeId u,
+                              bool edge_parallel = true,
+                              SimdLevel level = simd_level()) {
+  using NodeId = typename Graph::NodeId;
+  const T key = keys[u];
+  if constexpr (requires { G.edges[0].v; G.offsets[0]; } &&
+                std::is_same_v<NodeId, uint32_t>) {
+    if (sizeof(G.edges[0]) == sizeof(uint32_t) && G.n <= INT32_MAX) {
+      size_t lo = G.offsets[u], deg = G.offsets[u + 1] - lo;
+      if (deg == 0) return 0;
+      const uint32_t *idx = reinterpret_cast<const uint32_t *>(&G.edges[0]) + lo;
+      if (!edge_parallel || deg <= kEdgeParallelDegree) {
+        return count_gathered<kGreater>(keys, idx, deg, key, level);
+      }
+      size_t blocks = (deg + kCountBlock - 1) / kCountBlock;
+      auto partial = parlay::tabulate(blocks, [&](size_t b) {
+        size_t s = b * kCountBlock, e = std::min(deg, s + kCountBlock);
+        return count_gathered<kGreater>(keys, idx + s, e - s, key, level);
+      });
+      return parlay::reduce(partial);
+    }
+  }
+  size_t count = 0;
+  G.map_neighbors(u, [&](NodeId v) {
+    count += kGreater ? keys[v] > key : keys[v] < key;
+  });
+  return count;
+}
+
+#endif  // SIMD_COUNT_H
@@ -0,0 +1,280 @@
+#include "graph.h"
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+using namespace parlay;
+
+// 离线生成合成图，直接写 .bin（对称、去重、去自环、邻接表有序）
+//
+// 每个生成器都是“第 i 条边”的纯函数，边可以任意次重新生成，所以不需要把 m 条边
+// 存下来：第一遍只数度数，然后按源点把顶点切成若干段（每段的边数不超过 budget），
+// 每段再生成一遍所有边、只留源点落在本段的，按度数前缀和直接放进 CSR（counting sort），
+// 段内排序去重后追加写到文件。内存是 O(n + budget)。
+using NodeId = uint32_t;
+using EdgeId = uint64_t;
+
+inline uint64_t rand64(uint64_t seed, uint64_t i) {
+    return parlay::hash64(parlay::hash64(i) ^ (seed * 0x9e3779b97f4a7c15ull));
+}
+
+inline double rand01(uint64_t seed, uint64_t i) {
+    return static_cast<double>(rand64(seed, i) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Erdős–Rényi G(n, m)：每条边两个端点均匀随机
+struct ErdosRenyi {
+    size_t n, m;
+    uint64_t seed;
+    size_t num_edges() const { return m; }
+    bool edge(size_t i, NodeId& u, NodeId& v) const {
+        u = rand64(seed, 2 * i) % n;
+        v = rand64(seed, 2 * i + 1) % n;
+        return true;
+    }
+};
+
+// RMAT / Kronecker：每层按 (a, b, c, d) 选象限，默认 Graph500 参数
+struct RMAT {
+    size_t scale, m;
+    double a, b, c;
+    uint64_t seed;
+    size_t num_edges() const { return m; }
+    bool edge(size_t i, NodeId& u, NodeId& v) const {
+        u = 0;
+        v = 0;
+        for (size_t level = 0; level < scale; level++) {
+            double r = rand01(seed, i * scale + level);
+            u <<= 1;
+            v <<= 1;
+            if (r < a) {
+            } else if (r < a + b) {
+                v |= 1;
+            } else if (r < a + b + c) {
+                u |= 1;
+            } else {
+                u |= 1;
+                v |= 1;
+            }
+        }
+        // 打乱顶点编号，避免高度数顶点都集中在小编号
+        u = scramble(u);
+        v = scramble(v);
+        return true;
+    }
+    NodeId scramble(NodeId x) const {
+        // 2^scale 上的双射：奇数乘法 + 异或移位
+        uint64_t mask = (uint64_t(1) << scale) - 1;
+        uint64_t k1 = (rand64(seed, ~uint64_t(0)) | 1) & mask;
+        uint64_t k2 = (rand64(seed, ~uint64_t(1)) | 1) & mask;
+        uint64_t y = x;
+        y = (y * k1) & mask;
+        y ^= y >> (scale / 2 + 1);
+        y = (y * k2) & mask;
+        return static_cast<NodeId>(y);
+    }
+};
+
+// 2D/3D 网格：顶点 u 的第 d 个方向（+x, +y, +z）的边，越界就没有
+struct Grid {
+    size_t dim[3];
+    size_t dims;
+    size_t num_vertices() const { return dim[0] * dim[1] * (dims == 3 ? dim[2] : 1); }
+    size_t num_edges() const { return num_vertices() * dims; }
+    bool edge(size_t i, NodeId& u, NodeId& v) const {
+        size_t x = i / dims, d = i % dims;
+        size_t stride = 1;
+        for (size_t k = 0; k < d; k++) stride *= dim[k];
+        size_t coord = (x / stride) % dim[d];
+        if (coord + 1 >= dim[d]) return false;
+        u = x;
+        v = x + stride;
+        return true;
+    }
+};
+
+// Barabási–Albert：Sanders–Schulz 的通信无关做法。把边列表看成端点序列，
+// 第 i 条边的位置 2i 是新顶点 i/d，位置 2i+1 复制之前某个随机位置的端点；
+// 复制到奇数位置就继续往前追，所以每条边都能独立算出来。
+struct BarabasiAlbert {
+    size_t n, d;
+    uint64_t seed;
+    size_t num_edges() const { return n * d; }
+    NodeId endpoint(size_t pos) const {
+        while (pos & 1) {
+            size_t e = pos / 2;
+            if (e < d) return 0;   // 顶点 0 之前没有别的顶点，它的边都是自环，之后被丢掉
+            pos = rand64(seed, pos) % (2 * e);
+        }
+        return static_cast<NodeId>(pos / 2 / d);
+    }
+    bool edge(size_t i, NodeId& u, NodeId& v) const {
+        u = static_cast<NodeId>(i / d);
+        v = endpoint(2 * i + 1);
+        return true;
+    }
+};
+
+static void pwrite_all(int fd, const void* buf, size_t len, size_t offset) {
+    const char* p = static_cast<const char*>(buf);
+    while (len > 0) {
+        ssize_t w = pwrite(fd, p, std::min(len, size_t(1) << 30), offset);
+        if (w <= 0) {
+            std::cerr << "Error: write failed: " << std::strerror(errno) << std::endl;
+            abort();
+        }
+        p += w;
+        len -= w;
+        offset += w;
+    }
+}
+
+template <class Gen>
+void generate_bin(const Gen& gen, size_t n, size_t budget, const std::string& filename) {
+    size_t num = gen.num_edges();
+    internal::timer t;
+    // 第一遍：数（对称后、去重前的）度数
+    auto deg = sequence<std::atomic<EdgeId>>(n);
+    parallel_for(0, n, [&](size_t u) { deg[u].store(0, std::memory_order_relaxed); });
+    parallel_for(0, num, [&](size_t i) {
+        NodeId u, v;
+        if (!gen.edge(i, u, v) || u == v) return;
+        deg[u].fetch_add(1, std::memory_order_relaxed);
+        deg[v].fetch_add(1, std::memory_order_relaxed);
+    });
+    std::cout << "  degree pass: " << t.next_time() << "s" << std::endl;
+
+    // 按源点切段，每段的（去重前）边数不超过 budget；单个顶点超过 budget 时独占一段
+    std::vector<size_t> cuts = {0};
+    size_t acc = 0;
+    for (size_t u = 0; u < n; u++) {
+        size_t d = deg[u].load(std::memory_order_relaxed);
+        if (acc + d > budget && u > cuts.back()) {
+            cuts.push_back(u);
+            acc = 0;
+        }
+        acc += d;
+    }
+    cuts.push_back(n);
+
+    int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        std::cerr << "Error: Cannot open file " << filename << std::endl;
+        abort();
+    }
+    auto offsets = sequence<EdgeId>(n + 1);
+    size_t edge_base = 3 * 8 + (n + 1) * 8;
+    size_t m = 0;
+    for (size_t b = 0; b + 1 < cuts.size(); b++) {
+        size_t lo = cuts[b], hi = cuts[b + 1];
+        // counting sort：段内位置 = 度数前缀和
+        auto start = sequence<EdgeId>::from_function(hi - lo + 1, [&](size_t i) {
+            return i < hi - lo ? deg[lo + i].load(std::memory_order_relaxed) : EdgeId(0);
+        });
+        size_t cnt = scan_inplace(start);
+        start[hi - lo] = cnt;
+        auto cursor = sequence<std::atomic<EdgeId>>(hi - lo);
+        parallel_for(0, hi - lo, [&](size_t i) { cursor[i].store(start[i], std::memory_order_relaxed); });
+        auto buf = sequence<NodeId>::uninitialized(cnt);
+        parallel_for(0, num, [&](size_t i) {
+            NodeId u, v;
+            if (!gen.edge(i, u, v) || u == v) return;
+            if (u >= lo && u < hi) buf[cursor[u - lo].fetch_add(1, std::memory_order_relaxed)] = v;
+            if (v >= lo && v < hi) buf[cursor[v - lo].fetch_add(1, std::memory_order_relaxed)] = u;
+        });
+        // 每个顶点的邻接表排序去重，原地压缩到表头
+        auto new_deg = sequence<EdgeId>::from_function(hi - lo + 1, [&](size_t i) -> EdgeId {
+            if (i == hi - lo) return 0;
+            NodeId* first = buf.begin() + start[i];
+            NodeId* last = buf.begin() + start[i + 1];
+            std::sort(first, last);
+            return std::unique(first, last) - first;
+        });
+        size_t kept = scan_inplace(new_deg);
+        new_deg[hi - lo] = kept;
+        auto packed = sequence<NodeId>::uninitialized(kept);
+        parallel_for(0, hi - lo, [&](size_t i) {
+            std::copy(buf.begin() + start[i], buf.begin() + start[i] + (new_deg[i + 1] - new_deg[i]),
+                      packed.begin() + new_deg[i]);
+            offsets[lo + i] = m + new_deg[i];
+        });
+        pwrite_all(fd, packed.begin(), kept * sizeof(NodeId), edge_base + m * sizeof(NodeId));
+        m += kept;
+    }
+    offsets[n] = m;
+    std::cout << "  " << cuts.size() - 1 << " bucket(s): " << t.next_time() << "s" << std::endl;
+
+    size_t header[3] = {n, m, (n + 1) * 8 + m * 4 + 3 * 8};
+    pwrite_all(fd, header, sizeof(header), 0);
+    pwrite_all(fd, offsets.begin(), (n + 1) * sizeof(EdgeId), 3 * 8);
+    close(fd);
+    std::cout << filename << "  n=" << n << " m=" << m << std::endl;
+}
+
+void usage() {
+    std::cerr << "Usage: ./gen_graph <type> [options] -o output.bin\n"
+              << "  er     -n vertices -m edges\n"
+              << "  rmat   -n scale    -m edges   [-a 0.57 -b 0.19 -c 0.19]\n"
+              << "  grid2d -x cols -y rows\n"
+              << "  grid3d -x cols -y rows -z layers\n"
+              << "  ba     -n vertices -d edges_per_vertex\n"
+              << "common: [-s seed] [-B bucket_budget_edges (default 2^28)]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) { usage(); return 1; }
+    std::string type = argv[1];
+    size_t n = 0, m = 0, d = 4, x = 0, y = 0, z = 0, seed = 0;
+    size_t budget = size_t(1) << 28;
+    double a = 0.57, b = 0.19, c = 0.19;
+    std::string output;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) { usage(); return 1; }
+        std::string val = argv[++i];
+        if (arg == "-n") n = std::strtoull(val.c_str(), nullptr, 10);
+        else if (arg == "-m") m = std::strtoull(val.c_str(), nullptr, 10);
+        else if (arg == "-d") d = std::strtoull(val.c_str(), nullptr, 10);
+        else if (arg == "-x") x = std::strtoull(val.c_str(), nullptr, 10);
+        else if (arg == "-y") y = std::strtoull(val.c_str(), nullptr, 10);
+        else if (arg == "-z") z = std::strtoull(val.c_str(), nullptr, 10);
+        else if (arg == "-s") seed = std::strtoull(val.c_str(), nullptr, 10);
+        else if (arg == "-B") budget = std::strtoull(val.c_str(), nullptr, 10);
+        else if (arg == "-a") a = std::atof(val.c_str());
+        else if (arg == "-b") b = std::atof(val.c_str());
+        else if (arg == "-c") c = std::atof(val.c_str());
+        else if (arg == "-o") output = val;
+        else { usage(); return 1; }
+    }
+    if (output.empty() || budget == 0) { usage(); return 1; }
+
+    if (type == "er" && n > 0) {
+        generate_bin(ErdosRenyi{n, m, seed}, n, budget, output);
+    } else if (type == "rmat" && n > 0 && n < 32) {
+        if (a + b + c >= 1) { usage(); return 1; }
+        generate_bin(RMAT{n, m, a, b, c, seed}, size_t(1) << n, budget, output);
+    } else if (type == "grid2d" && x > 0 && y > 0) {
+        Grid g{{x, y, 1}, 2};
+        generate_bin(g, g.num_vertices(), budget, output);
+    } else if (type == "grid3d" && x > 0 && y > 0 && z > 0) {
+        Grid g{{x, y, z}, 3};
+        generate_bin(g, g.num_vertices(), budget, output);
+    } else if (type == "ba" && n > 0 && d > 0) {
+        generate_bin(BarabasiAlbert{n, d, seed}, n, budget, output);
+    } else {
+        usage();
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include "graph.h"
+#include <sys/stat.h>
+
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+using namespace parlay;
+
+// 比较同一个图文件的几种读法：吞吐（MB/s）以及读出来的图是否一致
+using IOGraph = Graph<uint32_t, uint64_t>;
+
+struct Reader {
+    std::string name;
+    std::function<void(IOGraph&, const char*)> read;
+};
+
+std::vector<Reader> readers_for(const std::string& filename, const std::string& ext) {
+    if (filename.find("hyperlink2012.bin") != std::string::npos) {
+        return {
+            {"ifstream", [](IOGraph& G, const char* f) { G.read_hyperlink2012(f); }},
+            {"pread", [](IOGraph& G, const char* f) { G.read_hyperlink2012_pread(f); }},
+        };
+    }
+    if (ext == "bin") {
+        return {
+            {"mmap", [](IOGraph& G, const char* f) { G.read_binary_format(f); }},
+            {"pread", [](IOGraph& G, const char* f) { G.read_binary_format_pread(f); }},
+        };
+    }
+    if (ext == "adj") {
+        return {
+            {"tokens", [](IOGraph& G, const char* f) { G.read_pbbs_format(f); }},
+            {"chunked", [](IOGraph& G, const char* f) { G.read_pbbs_format_chunked(f); }},
+        };
+    }
+    return {};
+}
+
+bool same_graph(const IOGraph& a, const IOGraph& b) {
+    if (a.n != b.n || a.m != b.m) return false;
+    auto diff_offsets = parlay::delayed_seq<bool>(a.n + 1, [&](size_t i) { return a.offsets[i] != b.offsets[i]; });
+    auto diff_edges = parlay::delayed_seq<bool>(a.m, [&](size_t i) { return a.edges[i].v != b.edges[i].v; });
+    return parlay::count(diff_offsets, true) == 0 && parlay::count(diff_edges, true) == 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 4) {
+        std::cerr << "Usage: ./io_bench graph_file [repetitions] [pread_chunk_MB]" << std::endl;
+        return 1;
+    }
+    const char* filename = argv[1];
+    int reps = argc >= 3 ? std::atoi(argv[2]) : 3;
+    size_t chunk = argc == 4 ? std::strtoull(argv[3], nullptr, 10) << 20 : IOGraph().io_chunk_size;
+    std::string str_filename(filename);
+    std::string ext = str_filename.substr(str_filename.find_last_of('.') + 1);
+    auto readers = readers_for(str_filename, ext);
+    struct stat sb;
+    if (readers.empty() || stat(filename, &sb) != 0 || reps < 1) {
+        std::cerr << "Error: need an existing .adj or .bin file" << std::endl;
+        return 1;
+    }
+    double mb = sb.st_size / 1e6;
+    std::cout << str_filename << "  " << mb << " MB  pread chunk " << (chunk >> 20) << " MB" << std::endl;
+
+    IOGraph reference;
+    for (size_t r = 0; r < readers.size(); r++) {
+        // 第一次可能是冷缓存，单独列出来
+        double first = 0, best = 0;
+        IOGraph G;
+        for (int i = 0; i < reps; i++) {
+            G = IOGraph();
+            G.io_chunk_size = chunk;
+            internal::timer t;
+            readers[r].read(G, filename);
+            t.stop();
+            if (i == 0) first = t.total_time();
+            if (i == 0 || t.total_time() < best) best = t.total_time();
+        }
+        std::cout << "    " << std::left << std::setw(9) << readers[r].name << std::right
+                  << "  first " << first << "s " << mb / first << " MB/s"
+                  << "  best " << best << "s " << mb / best << " MB/s";
+        if (r == 0) {
+            reference = std::move(G);
+        } else {
+            std::cout << (same_graph(reference, G) ? "  (matches " : "  (DIFFERS from ") << readers[0].name << ")";
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
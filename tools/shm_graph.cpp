@@ -0,0 +1,55 @@
+#include "graph.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include "parlay/parallel.h"
+#include "parlay/primitives.h"
+using namespace parlay;
+
+// 把（对称化后的）图常驻到 POSIX 共享内存里，之后的 mis / bench 进程用 shm:<name> 直接挂载，
+// 不用再读文件、再对称化。段在 unlink 之前一直存在，不需要常驻进程。
+void usage() {
+    std::cerr << "Usage: ./shm_graph load input_graph name [--symmetrize]\n"
+              << "       ./shm_graph info name\n"
+              << "       ./shm_graph unlink name\n"
+              << "name: a POSIX shm name (e.g. friendster), or a path on hugetlbfs\n"
+              << "input graphs named *_sym.* are taken as already symmetric" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) { usage(); return 1; }
+    std::string cmd = argv[1];
+    if (cmd == "load" && (argc == 4 || argc == 5)) {
+        const char* filename = argv[2];
+        std::string name = argv[3];
+        bool force = argc == 5 && std::string(argv[4]) == "--symmetrize";
+        internal::timer t;
+        Graph<uint32_t, uint64_t> G;
+        G.read_graph(filename);
+        std::cout << "read " << filename << ": " << t.next_time() << "s" << std::endl;
+        std::string stem = std::filesystem::path(filename).stem().string();
+        if (force || stem.find("_sym") == std::string::npos) {
+            G = make_symmetrized(G);
+            std::cout << "symmetrize: " << t.next_time() << "s" << std::endl;
+        }
+        publish_graph_shm(G, name);
+        std::cout << "published " << name << "  n=" << G.n << " m=" << G.m << "  " << t.next_time() << "s"
+                  << std::endl;
+    } else if (cmd == "info" && argc == 3) {
+        GraphView<uint32_t, uint64_t> G;
+        G.attach(argv[2]);
+        std::cout << argv[2] << "  n=" << G.n << " m=" << G.m << std::endl;
+    } else if (cmd == "unlink" && argc == 3) {
+        if (!unlink_graph_shm(argv[2])) {
+            std::cerr << "Error: Cannot unlink " << argv[2] << std::endl;
+            return 1;
+        }
+    } else {
+        usage();
+        return 1;
+    }
+    return 0;
+}
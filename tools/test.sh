@@ -0,0 +1,11 @@
+make clean
+make
+mkdir -p ../testcases/bin
+./gen_graph rmat -n 24 -m 268435456 -o ../testcases/bin/rmat24_sym.bin
+#./gen_graph er -n 16777216 -m 134217728 -o ../testcases/bin/er24_sym.bin
+#./gen_graph grid2d -x 4096 -y 4096 -o ../testcases/bin/grid2d_4096_sym.bin
+#./gen_graph grid3d -x 256 -y 256 -z 256 -o ../testcases/bin/grid3d_256_sym.bin
+#./gen_graph ba -n 16777216 -d 8 -o ../testcases/bin/ba24_sym.bin
+for g in $(grep -v '^#' ../testcases/graphnames.txt); do ./reorder ../testcases/bin/$g.bin --bench; done
+#./reorder ../testcases/bin/soc-LiveJournal1_sym.bin --bench
+#./reorder ../testcases/bin/friendster_sym.bin gorder ../testcases/bin/friendster_gorder_sym.bin
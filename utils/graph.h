@@ -65,6 +65,17 @@ class Graph {
   parlay::sequence<EdgeId> in_offsets;
   parlay::sequence<Edge> in_edges;
 
+  size_t degree(NodeId u) const { return offsets[u + 1] - offsets[u]; }
+
+  // Calls f(v) for every out-neighbor v of u. Implicit graphs
+  // (implicit_graph.h) provide the same two members.
+  template <class F>
+  void map_neighbors(NodeId u, F &&f) const {
+    for (EdgeId e = offsets[u]; e < offsets[u + 1]; e++) {
+      f(edges[e].v);
+    }
+  }
+
   auto in_neighors(NodeId u) const {
     if (symmetrized) {
       return edges.cut(offsets[u], offsets[u + 1]);